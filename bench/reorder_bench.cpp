@@ -0,0 +1,156 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <DSUWithData.hpp>
+
+namespace {
+    using Dsu = gdsu::DSUWithData<std::uint64_t>;
+
+    constexpr std::size_t numberOfQueries = 1 << 18;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // enum Layout
+    // Built: trees as left by joins.
+    // Flattened: compact() without tombstones, every element points to its
+    // root, indices are not changed.
+    // Reordered: reorder(), flattened and every component is contiguous.
+    enum Layout : std::int64_t {
+        Built,
+        Flattened,
+        Reordered
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Components of componentSize elements, each made of keys scattered
+    // over the whole keys range, as after a build from an unordered edges
+    // list.
+    Dsu buildScattered(std::size_t size, std::size_t componentSize) {
+        auto dsu = Dsu(std::views::iota(std::uint64_t(0), std::uint64_t(size)),
+                       std::bool_constant<true>());
+        auto keys = std::vector<std::uint64_t>(size);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(1));
+        auto gen = std::mt19937_64(2);
+        for (std::size_t begin = 0; begin < size; begin += componentSize) {
+            const std::size_t end = std::min(begin + componentSize, size);
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                // Random earlier element, so trees are not just stars.
+                dsu.join(keys[i], keys[begin + gen() % (i - begin)]);
+            }
+        }
+        return dsu;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Pristine built DSU of given layout. Benchmarks work on copies, so
+    // path compression of one benchmark does not leak into another.
+    const Dsu& getDsu(std::size_t size, std::size_t componentSize, Layout layout) {
+        static auto cache = std::map<std::tuple<std::size_t, std::size_t, Layout>, Dsu>();
+        const auto cacheKey = std::make_tuple(size, componentSize, layout);
+        if (auto it = cache.find(cacheKey); it != cache.end()) {
+            return it->second;
+        }
+        auto dsu = buildScattered(size, componentSize);
+        if (layout == Flattened) {
+            dsu.compact();
+        } else if (layout == Reordered) {
+            dsu.reorder();
+        }
+        return cache.emplace(cacheKey, std::move(dsu)).first->second;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<std::uint64_t> randomKeys(std::size_t size) {
+        auto gen = std::mt19937_64(3);
+        auto keys = std::vector<std::uint64_t>(numberOfQueries + 1);
+        for (auto& key : keys) {
+            key = gen() % size;
+        }
+        return keys;
+    }
+}
+
+//----------------------------------------------------------------------------//
+// First queries pass after a build, trees are not compressed by queries yet.
+// Args: number of elements, component size, layout.
+static void BM_QueriesAfterBuild(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto componentSize = static_cast<std::size_t>(state.range(1));
+    const auto& built = getDsu(size, componentSize, Layout(state.range(2)));
+    const auto keys = randomKeys(size);
+
+    // Copies are destroyed out of timed regions.
+    auto dsu = std::optional<Dsu>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        dsu.reset();
+        dsu.emplace(built);
+        state.ResumeTiming();
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < numberOfQueries; ++i) {
+            checksum += dsu->inSameComponent(keys[i], keys[i + 1]);
+            checksum += dsu->getComponentSize(keys[i]);
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * numberOfQueries);
+}
+BENCHMARK(BM_QueriesAfterBuild)
+        ->ArgsProduct({{1 << 22}, {4, 64, 1024}, {Built, Flattened, Reordered}})
+        ->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------//
+// Queries on trees already compressed by previous queries.
+// Args: number of elements, component size, layout.
+static void BM_RepeatedQueries(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto componentSize = static_cast<std::size_t>(state.range(1));
+    const auto dsu = getDsu(size, componentSize, Layout(state.range(2)));
+    const auto keys = randomKeys(size);
+
+    for (auto _ : state) {
+        std::size_t checksum = 0;
+        for (std::size_t i = 0; i < numberOfQueries; ++i) {
+            checksum += dsu.inSameComponent(keys[i], keys[i + 1]);
+            checksum += dsu.getComponentSize(keys[i]);
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * numberOfQueries);
+}
+BENCHMARK(BM_RepeatedQueries)
+        ->ArgsProduct({{1 << 22}, {4, 64, 1024}, {Built, Flattened, Reordered}})
+        ->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------//
+// Args: number of elements, component size.
+static void BM_Reorder(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto componentSize = static_cast<std::size_t>(state.range(1));
+    const auto& built = getDsu(size, componentSize, Built);
+
+    auto dsu = std::optional<Dsu>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        dsu.reset();
+        dsu.emplace(built);
+        state.ResumeTiming();
+        dsu->reorder();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Reorder)
+        ->ArgsProduct({{1 << 22}, {64}})
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,190 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_COMPONENT_STATS_HPP
+#define DSU_WITH_DATA_COMPONENT_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace gdsu {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // class NoComponentStats
+    // Statistics policy which tracks nothing. Used by default.
+    class NoComponentStats {
+    public:
+        void onConstruct(std::size_t) {}
+        void onJoin(std::size_t, std::size_t) {}
+        void onErase(std::size_t) {}
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // class ComponentStats
+    // Statistics policy which incrementally maintains components sizes
+    // distribution. Every join costs O(log n) additionally.
+    class ComponentStats {
+    public:
+        // Number of histogram buckets.
+        constexpr static std::size_t bucketsCount = 64;
+
+        // Called once all elements are added as singletons.
+        // @param numberOfElements - number of elements.
+        void onConstruct(std::size_t numberOfElements);
+
+        // Called when two components are joined.
+        // @param size1 - first component size.
+        // @param size2 - second component size.
+        void onJoin(std::size_t size1, std::size_t size2);
+
+        // Called when an element is erased from a component.
+        // @param size - component size before erasing.
+        void onErase(std::size_t size);
+
+        // Get maximum component size. O(1).
+        [[nodiscard]] std::size_t getMaxComponentSize() const;
+
+        // Get number of one element components. O(1).
+        [[nodiscard]] std::size_t getNumberOfSingletons() const;
+
+        // Get number of components with size greater than threshold. O(log n).
+        // @param threshold - size threshold.
+        [[nodiscard]] std::size_t
+        getNumberOfComponentsLargerThan(std::size_t threshold) const;
+
+        // Get components sizes histogram. Bucket i counts components with
+        // size in [2^i, 2^(i + 1)).
+        [[nodiscard]] const std::array<std::size_t, bucketsCount>&
+        getSizeHistogram() const;
+
+    private:
+
+        // Add delta to number of components of given size.
+        void _update(std::size_t size, std::ptrdiff_t delta);
+
+        // Get number of components with size not greater than given.
+        [[nodiscard]] std::size_t _countUpTo(std::size_t size) const;
+
+        // Find maximum size with nonzero number of components. O(log n).
+        [[nodiscard]] std::size_t _findMaxSize() const;
+
+        // Histogram bucket of the size.
+        static std::size_t _bucket(std::size_t size);
+
+    private:
+        // Fenwick tree over components sizes, 1-based.
+        std::vector<std::size_t> _sizesTree;
+        // Log buckets histogram.
+        std::array<std::size_t, bucketsCount> _histogram{};
+        // Number of components.
+        std::size_t _numberOfComponents{0};
+        // Maximum component size.
+        std::size_t _maxSize{0};
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+inline void gdsu::ComponentStats::onConstruct(std::size_t numberOfElements) {
+    _sizesTree.assign(numberOfElements + 1, 0);
+    _histogram.fill(0);
+    _numberOfComponents = 0;
+    _maxSize = 0;
+    if (numberOfElements != 0) {
+        _update(1, static_cast<std::ptrdiff_t>(numberOfElements));
+        _maxSize = 1;
+    }
+}
+
+//----------------------------------------------------------------------------//
+inline void gdsu::ComponentStats::onJoin(std::size_t size1, std::size_t size2) {
+    _update(size1, -1);
+    _update(size2, -1);
+    _update(size1 + size2, 1);
+    _maxSize = std::max(_maxSize, size1 + size2);
+}
+
+//----------------------------------------------------------------------------//
+inline void gdsu::ComponentStats::onErase(std::size_t size) {
+    _update(size, -1);
+    if (size > 1) {
+        _update(size - 1, 1);
+    }
+    if (size == _maxSize) {
+        _maxSize = _findMaxSize();
+    }
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::getMaxComponentSize() const {
+    return _maxSize;
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::getNumberOfSingletons() const {
+    return _histogram[0];
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::getNumberOfComponentsLargerThan(
+        std::size_t threshold) const {
+    return _numberOfComponents - _countUpTo(threshold);
+}
+
+//----------------------------------------------------------------------------//
+inline auto gdsu::ComponentStats::getSizeHistogram() const
+        -> const std::array<std::size_t, bucketsCount>& {
+    return _histogram;
+}
+
+//----------------------------------------------------------------------------//
+inline void gdsu::ComponentStats::_update(std::size_t size,
+                                          std::ptrdiff_t delta) {
+    for (std::size_t i = size; i < _sizesTree.size(); i += i & (~i + 1)) {
+        _sizesTree[i] += delta;
+    }
+    _histogram[_bucket(size)] += delta;
+    _numberOfComponents += delta;
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::_countUpTo(std::size_t size) const {
+    if (_sizesTree.empty()) {
+        return 0;
+    }
+    std::size_t ret = 0;
+    for (std::size_t i = std::min(size, _sizesTree.size() - 1); i > 0;
+         i -= i & (~i + 1)) {
+        ret += _sizesTree[i];
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::_findMaxSize() const {
+    if (_numberOfComponents == 0) {
+        return 0;
+    }
+    // Find the smallest size with all components not greater than it.
+    std::size_t pos = 0;
+    std::size_t rest = _numberOfComponents;
+    for (std::size_t step = std::bit_floor(_sizesTree.size()); step > 0;
+         step >>= 1) {
+        if (pos + step < _sizesTree.size() && _sizesTree[pos + step] < rest) {
+            pos += step;
+            rest -= _sizesTree[pos];
+        }
+    }
+    return pos + 1;
+}
+
+//----------------------------------------------------------------------------//
+inline std::size_t gdsu::ComponentStats::_bucket(std::size_t size) {
+    return std::bit_width(size) - 1;
+}
+
+#endif //DSU_WITH_DATA_COMPONENT_STATS_HPP
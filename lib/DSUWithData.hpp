@@ -5,30 +5,49 @@
 #ifndef DSU_WITH_DATA_DSU_WITH_DATA_HPP
 #define DSU_WITH_DATA_DSU_WITH_DATA_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 #include <variant>
-#include <map>
 #include <unordered_map>
-#include <set>
 #include <unordered_set>
 #include <stdexcept>
 #include <cassert>
 #include <numeric>
-#include <boost/range/adaptor/transformed.hpp>
+#include <optional>
+#include <thread>
+#include <ranges>
 
 #include "DefaultDSUData.hpp"
+#include "ComponentStats.hpp"
+#include "RootDataLayout.hpp"
+#include "EytzingerKeyIndex.hpp"
+#include "OffsetGroup.hpp"
+#include "ParallelFor.hpp"
 
 namespace gdsu {
+    template<class DSUT>
+    class FilterKruskal;
+
     /**
-     * @brief class DSUWithData<KeyT, RootDataT, SimpleDataT, Comp>
+     * @brief class DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>
+     * Component sizes are kept next to parent links and are the only
+     * sizes used for union by size and getComponentSize. Sizes kept by
+     * RootDataT itself are not read.
      * @tparam KeyT
      * @tparam RootDataT
      * @tparam Comp
+     * @tparam StatsT - components statistics policy (NoComponentStats or
+     * ComponentStats).
+     * @tparam OffsetGroupT - abelian group of offsets carried by parent
+     * links (NoOffsetGroup, AdditiveOffsetGroup, ParityOffsetGroup or
+     * user defined one with ValueType, identity, combine and invert).
      */
     template<class KeyT,
              class RootDataT = BaseRootDSUData<KeyT>,
-             class Comp = std::less<KeyT>>
+             class Comp = std::less<KeyT>,
+             class StatsT = NoComponentStats,
+             class OffsetGroupT = NoOffsetGroup>
     class DSUWithData {
     private:
 
@@ -40,13 +59,19 @@ namespace gdsu {
             bool operator()(const KeyT* key1, const KeyT* key2) const;
         };
 
-        /**
-         * struct KeyPtrEq
-         * Equality checking function for keys pointers.
-         */
-        struct KeyPtrEq {
-            bool operator()(const KeyT* key1, const KeyT* key2) const;
-        };
+        template<class DSUT>
+        friend class FilterKruskal;
+
+    public:
+        // Hot part of root data, stored next to parent links.
+        using HotData = typename RootDataLayout<RootDataT>::HotData;
+        // Root data is merged on request only.
+        constexpr static bool lazyJoin = RootDataLayout<RootDataT>::lazyJoin;
+        // Offset of an element relative to its parent.
+        using Offset = typename OffsetGroupT::ValueType;
+        // Parent links carry offsets.
+        constexpr static bool weighted =
+                !std::is_same_v<OffsetGroupT, NoOffsetGroup>;
 
     public:
 
@@ -102,12 +127,118 @@ namespace gdsu {
                     std::bool_constant<uniqueKeys> = std::bool_constant<false>());
 
         /**
-         * Join two components by keys.
+         * DSU constructor from any input range of keys. Keys are moved in
+         * if the range yields rvalues or is an owning container passed as
+         * rvalue, otherwise each key is copied once into its root data.
+         * Storage is presized if the range is sized.
+         * @tparam KeysRangeT - input range type.
+         * @tparam uniqueKeys - to check unique keys or not. If data is
+         * guaranteed to be unique, uniqueKeys should be `true.
+         * @param keys - keys range.
+         */
+        template<std::ranges::input_range KeysRangeT, bool uniqueKeys = false>
+        requires (!std::is_same_v<
+                          std::remove_cvref_t<std::ranges::range_reference_t<KeysRangeT>>,
+                          RootDataT>)
+                 && std::constructible_from<RootDataT,
+                                            std::ranges::range_reference_t<KeysRangeT>>
+        explicit DSUWithData(KeysRangeT&& keys,
+                             std::bool_constant<uniqueKeys> = std::bool_constant<false>());
+
+        /**
+         * DSU constructor from any input range of root data objects. Root
+         * data is moved in if the range yields rvalues or is an owning
+         * container passed as rvalue. Storage is presized if the range is
+         * sized.
+         * @tparam RootDataRangeT - input range type.
+         * @tparam uniqueKeys - to check unique keys or not. If data is
+         * guaranteed to be unique, uniqueKeys should be `true.
+         * @param rootData - root data range.
+         */
+        template<std::ranges::input_range RootDataRangeT, bool uniqueKeys = false>
+        requires std::is_same_v<
+                         std::remove_cvref_t<std::ranges::range_reference_t<RootDataRangeT>>,
+                         RootDataT>
+        explicit DSUWithData(RootDataRangeT&& rootData,
+                             std::bool_constant<uniqueKeys> = std::bool_constant<false>());
+
+        /**
+         * Join two components by keys. In weighted mode it is
+         * joinWithOffset with identity offset, keys already in one
+         * component are left as is even if their offset is not identity.
          * @param key1 - first key.
          * @param key2 - second key.
          */
         void join(const KeyT& key1, const KeyT& key2);
 
+        /**
+         * Join two components by keys with constraint
+         * "key1 - key2 = offset" in terms of the offsets group.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @param offset - offset of key1 relative to key2.
+         * @return `false if keys are already in one component and the
+         * constraint contradicts the known offset. DSU is not changed then.
+         */
+        bool joinWithOffset(const KeyT& key1, const KeyT& key2, const Offset& offset)
+        requires weighted;
+
+        /**
+         * Get offset of key1 relative to key2.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @return offset or std::nullopt if keys are of different components.
+         */
+        std::optional<Offset> getRelativeOffset(const KeyT& key1,
+                                                const KeyT& key2) const
+        requires weighted;
+
+        /**
+         * Erase key. The element is detached from its component through
+         * RootDataT::detach(key), its slot stays as a tombstone until
+         * compact(). Component disappears when its last element is erased.
+         * Root data of a component keeps its key even if that key is erased.
+         * @param key - key to erase.
+         */
+        void erase(const KeyT& key);
+
+        /**
+         * Drop tombstones: renumber live elements, flatten their trees and
+         * shrink storage. Works in O(n) plus finds of live elements. Lazy
+         * root data merges stay pending.
+         */
+        void compact();
+
+        /**
+         * Renumber elements so that every component occupies a contiguous
+         * range of indices with its root first, and flatten trees. Finds
+         * after a large build then stay within one component range instead
+         * of jumping across the whole nodes array. Tombstones are kept.
+         * Works in O(n), roots search and nodes rewriting run in parallel.
+         * @param numberOfThreads - number of threads.
+         */
+        void reorder(std::size_t numberOfThreads = std::thread::hardware_concurrency());
+
+        /**
+         * Get number of erased elements slots waiting for compaction.
+         * @return number of tombstones.
+         */
+        [[nodiscard]] std::size_t getNumberOfTombstones() const;
+
+        /**
+         * Get number of not erased keys.
+         * @return number of keys.
+         */
+        [[nodiscard]] std::size_t getNumberOfKeys() const;
+
+        /**
+         * Call function for every not erased key in ascending order.
+         * @tparam FunctionT - callable with (const KeyT&).
+         * @param function - function to call.
+         */
+        template<class FunctionT>
+        void forEachKey(FunctionT function) const;
+
         /**
          * Check if two keys are of the same component.
          * @param key1 - first key.
@@ -136,10 +267,46 @@ namespace gdsu {
          */
         const RootDataT& getRootData(const KeyT& key) const;
 
-    private:
+        /**
+         * Hot part of root data by key. Reads the same array as finds.
+         * @param key - key to search.
+         * @return hot data of the component.
+         */
+        const HotData& getRootHotData(const KeyT& key) const
+        requires (!std::is_same_v<HotData, NoHotData>);
 
         /**
-         * Fill parents relations data.
+         * Components statistics maintained during joins.
+         * @return statistics policy object.
+         */
+        const StatsT& getComponentStats() const
+        requires (!std::is_same_v<StatsT, NoComponentStats>);
+
+    protected:
+
+        /**
+         * Forward range element. Element is moved out if the range owns its
+         * elements and is passed as rvalue.
+         * @tparam RangeT - range type as it was passed to constructor.
+         * @param element - range element.
+         * @return element reference to construct from.
+         */
+        template<class RangeT, class ElementT>
+        static decltype(auto) _forwardElement(ElementT&& element);
+
+        /**
+         * Move root data objects in. If keys are not known to be unique,
+         * objects are indexed in keys order.
+         * @tparam uniqueKeys - to check unique keys or not.
+         * @param rootData - root data objects.
+         * @param skipRepeats - drop objects with repeating keys if `true,
+         * throw std::invalid_argument otherwise.
+         */
+        template<bool uniqueKeys>
+        void _emplaceRootData(std::vector<RootDataT>&& rootData, bool skipRepeats);
+
+        /**
+         * Fill parents relations data and build key index.
          */
         void _postConstruct();
 
@@ -157,6 +324,34 @@ namespace gdsu {
          */
         std::size_t _getRootIdxByIndex(std::size_t idx) const;
 
+        /**
+         * Root index and offset to root by element index. Path halving
+         * keeps offsets relative to new parents.
+         * @param idx - index if element.
+         * @return index of the root element of the component and offset of
+         * the element relative to it.
+         */
+        std::pair<std::size_t, Offset> _findRootWithOffset(std::size_t idx) const;
+
+        /**
+         * Root index by element index without path compression. Safe to
+         * call concurrently while the DSU is not modified.
+         * @param idx - index if element.
+         * @return index of the root element of the component.
+         */
+        std::size_t _findRootIdxConcurrent(std::size_t idx) const;
+
+        /**
+         * Root index and offset to root by element index without path
+         * compression. Safe to call concurrently while the DSU is not
+         * modified.
+         * @param idx - index if element.
+         * @return index of the root element of the component and offset of
+         * the element relative to it.
+         */
+        std::pair<std::size_t, Offset>
+        _findRootWithOffsetConcurrent(std::size_t idx) const;
+
         /**
          * Root data by component element index.
          * @param idx - component element index.
@@ -175,8 +370,11 @@ namespace gdsu {
          * Join two components.
          * @param comp1Idx - first component index.
          * @param comp2Idx - second component index.
+         * @param offset - offset of the first root relative to the second.
          */
-        void _join(std::size_t comp1Idx, std::size_t comp2Idx);
+        void _join(std::size_t comp1Idx,
+                   std::size_t comp2Idx,
+                   const Offset& offset = OffsetGroupT::identity());
 
         /**
          * Root data by root index.
@@ -192,164 +390,227 @@ namespace gdsu {
          */
         const RootDataT& _getRootData(std::size_t rootIdx) const;
 
-    private:
-        // Parents relations info
-        mutable std::vector<std::size_t> _parents;
-        // Vector with data objects
-        std::unordered_map<std::size_t, RootDataT> _data;
+        /**
+         * Merge root data of all components joined into the given one
+         * lazily.
+         * @param rootIdx - root index.
+         */
+        void _resolveMerges(std::size_t rootIdx) const;
+
+    protected:
+
+        /**
+         * struct _Node
+         * Parent link with fields read on every root access. Size and hot
+         * data are valid for roots only. Offset is relative to the parent,
+         * identity for roots.
+         */
+        struct _Node {
+            std::size_t parent;
+            std::size_t size;
+            [[no_unique_address]] HotData hot;
+            [[no_unique_address]] Offset offset;
+        };
+
+    protected:
+        // Parents relations info with hot root fields
+        mutable std::vector<_Node> _nodes;
+        // Cold part of root data. Also keeps not merged data of joined
+        // components in lazy mode.
+        mutable std::unordered_map<std::size_t, RootDataT> _data;
+        // Lazy mode: components joined into the index, in join order
+        mutable std::unordered_map<std::size_t, std::vector<std::size_t>>
+                _pendingMerges;
+        // Number of components
+        std::size_t _numberOfComponents{0};
         // Key to index mapping
-        std::map<KeyT, std::size_t, Comp> _keyToIndex;
+        EytzingerKeyIndex<KeyT, Comp> _keyIndex;
+        // Erased elements flags
+        std::vector<bool> _erased;
+        // Number of erased elements
+        std::size_t _numberOfTombstones{0};
+        // Components statistics
+        [[no_unique_address]] StatsT _stats;
     };
 }
 
-#endif //DSU_WITH_DATA_DSU_WITH_DATA_HPP
-
 ////////////////////////////////////////////////////////////////////////////////
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 template<bool uniqueKeys>
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::DSUWithData(
-        std::initializer_list<KeyT> keys, std::bool_constant<uniqueKeys>) {
-    if constexpr(uniqueKeys) {
-        for (const auto [keyIt, currIdx] = { keys.begin(), std::size_t(0) };
-             keyIt != keys.end();
-             ++keyIt) {
-            _data.emplace(std::make_pair(currIdx, RootDataT(keyIt)));
-            ++currIdx;
-        }
-    } else {
-        auto addedKeysRng = keys
-                | boost::adaptors::transformed([](auto& key) { return &key; });
-        auto addedKeys = std::vector(addedKeysRng.begin(), addedKeysRng.end());
-        std::sort(addedKeys.begin(), addedKeys.end(), KeyPtrComp());
-        auto uniqueEnd = std::unique(addedKeys.begin(), addedKeys.end(), KeyPtrEq());
-        for (auto keyIt = addedKeys.begin(); keyIt < uniqueEnd; ++keyIt) {
-            _data.emplace(std::make_pair(keyIt - addedKeys.begin(), RootDataT(**keyIt)));
-        }
-    }
-    _postConstruct();
-}
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
+        std::initializer_list<KeyT> keys, std::bool_constant<uniqueKeys> flag)
+        : DSUWithData(std::ranges::subrange(keys.begin(), keys.end()), flag) {}
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 template<bool uniqueKeys>
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::DSUWithData(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
         std::initializer_list<RootDataT> rootData,
-        std::bool_constant<uniqueKeys>) {
-    if constexpr (uniqueKeys) {
-        for (auto [rootDataIt, currIdx] = std::make_pair(rootData.begin(), std::size_t(0));
-             rootDataIt != rootData.end();
-             ++rootDataIt, ++currIdx) {
-            _data.emplace(std::make_pair(currIdx, RootDataT(*rootDataIt)));
-            ++currIdx;
-        }
-    } else {
-        auto addedKeys = std::set<const KeyT*, KeyPtrComp>();
-        for (const auto& rootDataI : rootData) {
-            if (const auto& newKey = rootDataI.getKey();
-                    addedKeys.contains(&newKey)) {
-                throw std::invalid_argument("Root data keys must not repeat.");
-            } else {
-                _data.emplace(
-                        std::make_pair(addedKeys.size(), RootDataT(rootDataI)));
-                addedKeys.insert(&newKey);
-            }
-        }
+        std::bool_constant<uniqueKeys> flag)
+        : DSUWithData(std::ranges::subrange(rootData.begin(), rootData.end()),
+                      flag) {}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<class IteratorT, bool uniqueKeys>
+requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
+         && std::constructible_from<RootDataT, KeyT>
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
+        IteratorT begin, IteratorT end, std::bool_constant<uniqueKeys> flag)
+        : DSUWithData(std::ranges::subrange(begin, end), flag) {}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<class IteratorT, bool uniqueKeys>
+requires std::is_same_v<std::iter_value_t<IteratorT>, RootDataT>
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
+        IteratorT begin, IteratorT end, std::bool_constant<uniqueKeys> flag)
+        : DSUWithData(std::ranges::subrange(begin, end), flag) {}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<std::ranges::input_range KeysRangeT, bool uniqueKeys>
+requires (!std::is_same_v<
+                  std::remove_cvref_t<std::ranges::range_reference_t<KeysRangeT>>,
+                  RootDataT>)
+         && std::constructible_from<RootDataT,
+                                    std::ranges::range_reference_t<KeysRangeT>>
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
+        KeysRangeT&& keys, std::bool_constant<uniqueKeys>) {
+    auto rootData = std::vector<RootDataT>();
+    if constexpr (std::ranges::sized_range<KeysRangeT>) {
+        rootData.reserve(std::ranges::size(keys));
+    }
+    for (auto&& key : keys) {
+        rootData.emplace_back(
+                _forwardElement<KeysRangeT>(std::forward<decltype(key)>(key)));
     }
 
+    _emplaceRootData<uniqueKeys>(std::move(rootData), true);
     _postConstruct();
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-template<class IteratorT, bool uniqueKeys>
-requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
-         && std::constructible_from<RootDataT, KeyT>
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::DSUWithData(
-        IteratorT begin, IteratorT end, std::bool_constant<uniqueKeys>) {
-    if constexpr(uniqueKeys) {
-        for (auto [keyIt, currIdx] = std::make_pair(begin, std::size_t(0));
-             keyIt != end;
-             ++keyIt, ++currIdx) {
-            _data.emplace(std::make_pair(currIdx, RootDataT(*keyIt)));
-        }
-    } else {
-        auto addedKeysRng = boost::iterator_range<IteratorT>(begin, end)
-                            | boost::adaptors::transformed([](auto& key) { return &key; });
-        auto addedKeys = std::vector(addedKeysRng.begin(), addedKeysRng.end());
-        std::sort(addedKeys.begin(), addedKeys.end(), KeyPtrComp());
-        auto uniqueEnd = std::unique(addedKeys.begin(), addedKeys.end(), KeyPtrEq());
-        for (auto keyIt = addedKeys.begin(); keyIt < uniqueEnd; ++keyIt) {
-            _data.emplace(std::make_pair(keyIt - addedKeys.begin(), RootDataT(**keyIt)));
-        }
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<std::ranges::input_range RootDataRangeT, bool uniqueKeys>
+requires std::is_same_v<
+                 std::remove_cvref_t<std::ranges::range_reference_t<RootDataRangeT>>,
+                 RootDataT>
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::DSUWithData(
+        RootDataRangeT&& rootData, std::bool_constant<uniqueKeys>) {
+    auto movedRootData = std::vector<RootDataT>();
+    if constexpr (std::ranges::sized_range<RootDataRangeT>) {
+        movedRootData.reserve(std::ranges::size(rootData));
+    }
+    for (auto&& rootDataI : rootData) {
+        movedRootData.emplace_back(_forwardElement<RootDataRangeT>(
+                std::forward<decltype(rootDataI)>(rootDataI)));
     }
 
+    _emplaceRootData<uniqueKeys>(std::move(movedRootData), false);
     _postConstruct();
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-template<class IteratorT, bool uniqueKeys>
-requires std::is_same_v<std::iter_value_t<IteratorT>, RootDataT>
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::DSUWithData(
-        IteratorT begin, IteratorT end, std::bool_constant<uniqueKeys>) {
-    if constexpr(uniqueKeys) {
-        for (auto [rootDataIt, currIdx] = { begin, std::size_t(0) };
-             rootDataIt != end;
-             ++rootDataIt, ++currIdx) {
-            const KeyT& keyRef = rootDataIt->getKey();
-            _data.emplace(std::make_pair(currIdx, RootDataT(*rootDataIt)));
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<class RangeT, class ElementT>
+decltype(auto)
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_forwardElement(
+        ElementT&& element) {
+    if constexpr (!std::is_lvalue_reference_v<RangeT>
+                  && !std::ranges::view<std::remove_cvref_t<RangeT>>) {
+        return std::move(element);
+    } else {
+        return std::forward<ElementT>(element);
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<bool uniqueKeys>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_emplaceRootData(
+        std::vector<RootDataT>&& rootData, bool skipRepeats) {
+    _data.reserve(rootData.size());
+
+    if constexpr (uniqueKeys) {
+        for (std::size_t i = 0; i < rootData.size(); ++i) {
+            _data.emplace(i, std::move(rootData[i]));
         }
     } else {
-        auto addedKeys = std::set<const KeyT*, KeyPtrComp>();
-        for (auto rootDataIt = begin; rootDataIt != end; ++rootDataIt) {
-            const KeyT& keyRef = rootDataIt->getKey();
-            if (addedKeys.contains(&keyRef)) {
+        // Sort indices, not objects, so root data is moved only once.
+        auto order = std::vector<std::size_t>(rootData.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+                         [&rootData](std::size_t idx1, std::size_t idx2) {
+                             return Comp()(rootData[idx1].getKey(),
+                                           rootData[idx2].getKey());
+                         });
+
+        const KeyT* lastKey = nullptr;
+        for (const std::size_t idx : order) {
+            if (lastKey != nullptr && !Comp()(*lastKey, rootData[idx].getKey())) {
+                if (skipRepeats) {
+                    continue;
+                }
                 throw std::invalid_argument("Root data keys must not repeat.");
             }
-            _data.emplace(std::make_pair(addedKeys.size(), RootDataT(*rootDataIt)));
-            addedKeys.insert(&keyRef);
+            const auto [dataIt, inserted] =
+                    _data.emplace(_data.size(), std::move(rootData[idx]));
+            lastKey = &dataIt->second.getKey();
         }
     }
-
-    _postConstruct();
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 void
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_join(
-        std::size_t rootIdx1, std::size_t rootIdx2) {
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_join(
+        std::size_t rootIdx1, std::size_t rootIdx2, const Offset& offset) {
 
     std::size_t smallerComponentRootIdx;
     std::size_t biggerComponentRootIdx;
-    RootDataT* smallerDataPtr;
-    RootDataT* biggerDataPtr;
+    Offset smallerRootOffset = offset;
 
-    if (auto& firstData = _getRootData(rootIdx1),
-              secondData = _getRootData(rootIdx2);
-    firstData.getSize() < secondData.getSize()) {
+    if (_nodes[rootIdx1].size < _nodes[rootIdx2].size) {
         smallerComponentRootIdx = rootIdx1;
         biggerComponentRootIdx = rootIdx2;
-        smallerDataPtr = &firstData;
-        biggerDataPtr = &secondData;
     } else {
         smallerComponentRootIdx = rootIdx2;
         biggerComponentRootIdx = rootIdx1;
-        smallerDataPtr = &secondData;
-        biggerDataPtr = &firstData;
+        smallerRootOffset = OffsetGroupT::invert(offset);
     }
 
-    _parents[smallerComponentRootIdx] = biggerComponentRootIdx;
-    biggerDataPtr->joinWith(*smallerDataPtr);
-    _data.erase(smallerComponentRootIdx);
+    auto& smallerNode = _nodes[smallerComponentRootIdx];
+    auto& biggerNode = _nodes[biggerComponentRootIdx];
+
+    smallerNode.parent = biggerComponentRootIdx;
+    smallerNode.offset = smallerRootOffset;
+    _stats.onJoin(smallerNode.size, biggerNode.size);
+    biggerNode.size += smallerNode.size;
+    biggerNode.hot.joinWith(smallerNode.hot);
+
+    --_numberOfComponents;
+
+    if constexpr (lazyJoin) {
+        _pendingMerges[biggerComponentRootIdx].push_back(smallerComponentRootIdx);
+    } else {
+        _getRootData(biggerComponentRootIdx).joinWith(
+                _getRootData(smallerComponentRootIdx));
+        _data.erase(smallerComponentRootIdx);
+    }
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 void
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::join(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::join(
         const KeyT &key1, const KeyT &key2) {
+    if constexpr (weighted) {
+        joinWithOffset(key1, key2, OffsetGroupT::identity());
+        return;
+    }
+
     const std::size_t rootIdx1 = _getRootIdxByIndex(_getIdxByKey(key1));
     const std::size_t rootIdx2 = _getRootIdxByIndex(_getIdxByKey(key2));
 
@@ -359,91 +620,443 @@ gdsu::DSUWithData<KeyT, RootDataT, Comp>::join(
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-bool gdsu::DSUWithData<KeyT, RootDataT, Comp>::inSameComponent(
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+bool
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::joinWithOffset(
+        const KeyT& key1, const KeyT& key2, const Offset& offset)
+requires weighted {
+    const auto [rootIdx1, offset1] = _findRootWithOffset(_getIdxByKey(key1));
+    const auto [rootIdx2, offset2] = _findRootWithOffset(_getIdxByKey(key2));
+
+    if (rootIdx1 == rootIdx2) {
+        return OffsetGroupT::combine(offset1, OffsetGroupT::invert(offset2))
+            == offset;
+    }
+
+    // root1 - root2 = (key1 - key2) - (key1 - root1) + (key2 - root2)
+    _join(rootIdx1, rootIdx2,
+          OffsetGroupT::combine(
+                  OffsetGroupT::combine(offset, OffsetGroupT::invert(offset1)),
+                  offset2));
+    return true;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+auto
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getRelativeOffset(
+        const KeyT& key1, const KeyT& key2) const -> std::optional<Offset>
+requires weighted {
+    const auto [rootIdx1, offset1] = _findRootWithOffset(_getIdxByKey(key1));
+    const auto [rootIdx2, offset2] = _findRootWithOffset(_getIdxByKey(key2));
+
+    if (rootIdx1 != rootIdx2) {
+        return std::nullopt;
+    }
+    return OffsetGroupT::combine(offset1, OffsetGroupT::invert(offset2));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::erase(
+        const KeyT& key) {
+    const std::size_t idx = _getIdxByKey(key);
+    const std::size_t rootIdx = _getRootIdxByIndex(idx);
+    auto& rootNode = _nodes[rootIdx];
+
+    _keyIndex.erase(key);
+    _erased[idx] = true;
+    ++_numberOfTombstones;
+
+    _stats.onErase(rootNode.size);
+    _getRootData(rootIdx).detach(key);
+    if constexpr (requires { rootNode.hot.detach(key); }) {
+        rootNode.hot.detach(key);
+    }
+    if (--rootNode.size == 0) {
+        _data.erase(rootIdx);
+        --_numberOfComponents;
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::compact() {
+    constexpr auto npos = EytzingerKeyIndex<KeyT, Comp>::npos;
+
+    // Live element which replaces dead root of its component.
+    auto rootSubstitutes = std::vector<std::size_t>(_nodes.size(), npos);
+    auto newIndices = std::vector<std::size_t>(_nodes.size(), npos);
+    // Offsets relative to old roots, weighted mode only.
+    auto offsets = std::vector<Offset>(weighted ? _nodes.size() : 0);
+    std::size_t numberOfLive = 0;
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+        if (!_erased[i]) {
+            newIndices[i] = numberOfLive++;
+            const auto [rootIdx, offset] = _findRootWithOffset(i);
+            if constexpr (weighted) {
+                offsets[i] = offset;
+            }
+            if (!_erased[rootIdx]) {
+                rootSubstitutes[rootIdx] = rootIdx;
+            } else if (rootSubstitutes[rootIdx] == npos) {
+                rootSubstitutes[rootIdx] = i;
+            }
+        }
+    }
+
+    auto newNodes = std::vector<_Node>();
+    newNodes.reserve(numberOfLive);
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+        if (!_erased[i]) {
+            const std::size_t substitute = rootSubstitutes[_getRootIdxByIndex(i)];
+            newNodes.push_back(_nodes[i]);
+            newNodes.back().parent = newIndices[substitute];
+            if constexpr (weighted) {
+                newNodes.back().offset = substitute == i
+                        ? OffsetGroupT::identity()
+                        : OffsetGroupT::combine(
+                                offsets[i], OffsetGroupT::invert(offsets[substitute]));
+            }
+        }
+    }
+    // Substitutes take over hot fields of dead roots.
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+        if (const std::size_t substitute = rootSubstitutes[i];
+                substitute != npos && substitute != i) {
+            auto& newRootNode = newNodes[newIndices[substitute]];
+            newRootNode.size = _nodes[i].size;
+            newRootNode.hot = _nodes[i].hot;
+        }
+    }
+
+    // Roots data go to substitutes. Data of pending merges keeps its index
+    // if it is live and free, otherwise takes a free one: every pending
+    // component has a live element of its own, so free indices suffice.
+    auto dataIndices = std::unordered_map<std::size_t, std::size_t>();
+    dataIndices.reserve(_data.size());
+    auto takenIndices = std::vector<bool>(numberOfLive, false);
+    for (const auto& [idx, rootData] : _data) {
+        if (_nodes[idx].parent == idx) {
+            const std::size_t newIdx = newIndices[rootSubstitutes[idx]];
+            dataIndices.emplace(idx, newIdx);
+            takenIndices[newIdx] = true;
+        }
+    }
+    if constexpr (lazyJoin) {
+        for (const auto& [idx, rootData] : _data) {
+            if (_nodes[idx].parent != idx && !_erased[idx]
+                    && !takenIndices[newIndices[idx]]) {
+                dataIndices.emplace(idx, newIndices[idx]);
+                takenIndices[newIndices[idx]] = true;
+            }
+        }
+        std::size_t freeIdx = 0;
+        for (const auto& [idx, rootData] : _data) {
+            if (!dataIndices.contains(idx)) {
+                while (takenIndices[freeIdx]) {
+                    ++freeIdx;
+                }
+                dataIndices.emplace(idx, freeIdx);
+                takenIndices[freeIdx] = true;
+            }
+        }
+    }
+
+    auto newData = std::unordered_map<std::size_t, RootDataT>();
+    newData.reserve(_data.size());
+    for (auto& [idx, rootData] : _data) {
+        newData.emplace(dataIndices.at(idx), std::move(rootData));
+    }
+
+    auto newPendingMerges =
+            std::unordered_map<std::size_t, std::vector<std::size_t>>();
+    newPendingMerges.reserve(_pendingMerges.size());
+    for (auto& [idx, children] : _pendingMerges) {
+        for (auto& childIdx : children) {
+            childIdx = dataIndices.at(childIdx);
+        }
+        newPendingMerges.emplace(dataIndices.at(idx), std::move(children));
+    }
+
+    _keyIndex = _keyIndex.compacted(newIndices);
+    _nodes = std::move(newNodes);
+    _data = std::move(newData);
+    _pendingMerges = std::move(newPendingMerges);
+    _erased.assign(numberOfLive, false);
+    _numberOfTombstones = 0;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::reorder(
+        std::size_t numberOfThreads) {
+    numberOfThreads = std::max<std::size_t>(numberOfThreads, 1);
+    const std::size_t n = _nodes.size();
+
+    // Trees are not modified, so roots are searched concurrently.
+    auto roots = std::vector<std::size_t>(n);
+    // Offsets relative to roots, weighted mode only.
+    auto offsets = std::vector<Offset>(weighted ? n : 0);
+    parallelFor(n, numberOfThreads,
+                [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            const auto [rootIdx, offset] = _findRootWithOffsetConcurrent(i);
+            roots[i] = rootIdx;
+            if constexpr (weighted) {
+                offsets[i] = offset;
+            }
+        }
+    });
+
+    // Components ranges follow roots order, elements of a component keep
+    // their relative order. Tombstones stay in their components.
+    auto newIndices = std::vector<std::size_t>(n);
+    auto nextIndices = std::vector<std::size_t>(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        ++nextIndices[roots[i]];
+    }
+    for (std::size_t i = 0, rangeBegin = 0; i < n; ++i) {
+        if (roots[i] == i) {
+            const std::size_t rangeSize = nextIndices[i];
+            newIndices[i] = rangeBegin;
+            nextIndices[i] = rangeBegin + 1;
+            rangeBegin += rangeSize;
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (roots[i] != i) {
+            newIndices[i] = nextIndices[roots[i]]++;
+        }
+    }
+
+    auto newNodes = _nodes;
+    parallelFor(n, numberOfThreads,
+                [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            auto& newNode = newNodes[newIndices[i]];
+            newNode = _nodes[i];
+            newNode.parent = newIndices[roots[i]];
+            if constexpr (weighted) {
+                newNode.offset = offsets[i];
+            }
+        }
+    });
+
+    auto newErased = std::vector<bool>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        newErased[newIndices[i]] = _erased[i];
+    }
+
+    auto newData = std::unordered_map<std::size_t, RootDataT>();
+    newData.reserve(_data.size());
+    for (auto& [idx, rootData] : _data) {
+        newData.emplace(newIndices[idx], std::move(rootData));
+    }
+
+    auto newPendingMerges =
+            std::unordered_map<std::size_t, std::vector<std::size_t>>();
+    newPendingMerges.reserve(_pendingMerges.size());
+    for (auto& [idx, children] : _pendingMerges) {
+        for (auto& childIdx : children) {
+            childIdx = newIndices[childIdx];
+        }
+        newPendingMerges.emplace(newIndices[idx], std::move(children));
+    }
+
+    _keyIndex.renumber(newIndices);
+    _nodes = std::move(newNodes);
+    _erased = std::move(newErased);
+    _data = std::move(newData);
+    _pendingMerges = std::move(newPendingMerges);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+std::size_t
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getNumberOfTombstones() const {
+    return _numberOfTombstones;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+std::size_t
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getNumberOfKeys() const {
+    return _keyIndex.size() - _numberOfTombstones;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+template<class FunctionT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::forEachKey(
+        FunctionT function) const {
+    _keyIndex.forEach(std::move(function));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+bool gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::inSameComponent(
         const KeyT& key1, const KeyT& key2) const {
     return _getRootIdxByIndex(_getIdxByKey(key1))
         == _getRootIdxByIndex(_getIdxByKey(key2));
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 std::size_t
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::getNumberOfComponents() const {
-    return _data.size();
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getNumberOfComponents() const {
+    return _numberOfComponents;
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 const RootDataT&
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::getRootData(const KeyT& key) const {
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getRootData(
+        const KeyT& key) const {
     return _getRootDataByIndex(_getIdxByKey(key));
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+auto
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getRootHotData(
+        const KeyT& key) const -> const HotData&
+requires (!std::is_same_v<HotData, NoHotData>) {
+    return _nodes[_getRootIdxByIndex(_getIdxByKey(key))].hot;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+const StatsT&
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getComponentStats() const
+requires (!std::is_same_v<StatsT, NoComponentStats>) {
+    return _stats;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 std::size_t
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootIdxByIndex(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getRootIdxByIndex(
         std::size_t idx) const {
-    if(std::size_t parentIdx = _parents[idx]; parentIdx != idx) {
+    return _findRootWithOffset(idx).first;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+auto
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_findRootWithOffset(
+        std::size_t idx) const -> std::pair<std::size_t, Offset> {
+    auto offset = OffsetGroupT::identity();
+    while (_nodes[idx].parent != idx) {
+        auto& node = _nodes[idx];
+        const auto& parentNode = _nodes[node.parent];
         // Rejoin
-        _parents[idx] = _parents[parentIdx];
-        return _getRootIdxByIndex(_parents[parentIdx]);
+        node.offset = OffsetGroupT::combine(node.offset, parentNode.offset);
+        node.parent = parentNode.parent;
+        offset = OffsetGroupT::combine(offset, node.offset);
+        idx = node.parent;
+    }
+    return {idx, offset};
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+std::size_t
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_findRootIdxConcurrent(
+        std::size_t idx) const {
+    while (_nodes[idx].parent != idx) {
+        idx = _nodes[idx].parent;
     }
     return idx;
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 auto
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootDataByIndex(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_findRootWithOffsetConcurrent(
+        std::size_t idx) const -> std::pair<std::size_t, Offset> {
+    auto offset = OffsetGroupT::identity();
+    while (_nodes[idx].parent != idx) {
+        offset = OffsetGroupT::combine(offset, _nodes[idx].offset);
+        idx = _nodes[idx].parent;
+    }
+    return {idx, offset};
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+auto
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getRootDataByIndex(
         std::size_t idx) -> RootDataT& {
     return _getRootData(_getRootIdxByIndex(idx));
 }
 
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 auto
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootDataByIndex(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getRootDataByIndex(
         std::size_t idx) const -> const RootDataT& {
     return _getRootData(_getRootIdxByIndex(idx));
 }
 
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-void gdsu::DSUWithData<KeyT, RootDataT, Comp>::_postConstruct() {
-    _parents.resize(_data.size());
-    std::iota(_parents.begin(), _parents.end(), 0);
-    for (auto& [i, rootData] : _data) {
-        _keyToIndex[rootData.getKey()] = i;
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_postConstruct() {
+    _nodes.clear();
+    _nodes.reserve(_data.size());
+    for (std::size_t i = 0; i < _data.size(); ++i) {
+        _nodes.push_back(
+                _Node{i, 1, HotData(_getRootData(i)), OffsetGroupT::identity()});
+    }
+
+    auto keysWithIndices = std::vector<std::pair<const KeyT*, std::size_t>>();
+    keysWithIndices.reserve(_data.size());
+    for (std::size_t i = 0; i < _data.size(); ++i) {
+        keysWithIndices.emplace_back(&_getRootData(i).getKey(), i);
+    }
+    // Deduplicating constructors already produce sorted keys.
+    const auto pairComp = [](const auto& pair1, const auto& pair2) {
+        return KeyPtrComp()(pair1.first, pair2.first);
+    };
+    if (!std::is_sorted(keysWithIndices.begin(), keysWithIndices.end(), pairComp)) {
+        std::sort(keysWithIndices.begin(), keysWithIndices.end(), pairComp);
     }
+    _keyIndex = EytzingerKeyIndex<KeyT, Comp>(keysWithIndices);
+    _erased.assign(_data.size(), false);
+    _numberOfComponents = _data.size();
+    _stats.onConstruct(_data.size());
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-size_t gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getIdxByKey(
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+size_t gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getIdxByKey(
         const KeyT &key) const {
-    if (auto it = _keyToIndex.find(key); it == _keyToIndex.end()) {
+    if (const std::size_t idx = _keyIndex.find(key);
+            idx == EytzingerKeyIndex<KeyT, Comp>::npos) {
         throw std::invalid_argument("No such key.");
     } else {
-        return it->second;
+        return idx;
     }
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 std::size_t
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::getComponentSize(const KeyT& key) const {
-    return _getRootDataByIndex(_getIdxByKey(key)).getSize();
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::getComponentSize(
+        const KeyT& key) const {
+    return _nodes[_getRootIdxByIndex(_getIdxByKey(key))].size;
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 auto
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootData(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getRootData(
         std::size_t rootIdx) -> RootDataT& {
+    if constexpr (lazyJoin) {
+        _resolveMerges(rootIdx);
+    }
     if (auto dataIt = _data.find(rootIdx); dataIt == _data.end()) {
         throw std::runtime_error("No root data in index.");
     } else {
@@ -452,10 +1065,13 @@ gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootData(
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
 auto
-gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootData(
+gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_getRootData(
         std::size_t rootIdx) const -> const RootDataT& {
+    if constexpr (lazyJoin) {
+        _resolveMerges(rootIdx);
+    }
     if (auto dataIt = _data.find(rootIdx); dataIt == _data.end()) {
         throw std::runtime_error("No root data in index.");
     } else {
@@ -464,15 +1080,47 @@ gdsu::DSUWithData<KeyT, RootDataT, Comp>::_getRootData(
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-bool gdsu::DSUWithData<KeyT, RootDataT, Comp>::KeyPtrComp::operator()(
-        const KeyT* key1, const KeyT* key2) const {
-    return Comp()(*key1, *key2);
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+void gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::_resolveMerges(
+        std::size_t rootIdx) const {
+    if (_pendingMerges.empty() || !_pendingMerges.contains(rootIdx)) {
+        return;
+    }
+
+    // Every component is fully merged before it is merged into its parent,
+    // children are merged in join order, as it is done by eager joins.
+    auto order = std::vector<std::size_t>();
+    auto toVisit = std::vector<std::size_t>{rootIdx};
+    while (!toVisit.empty()) {
+        const std::size_t idx = toVisit.back();
+        toVisit.pop_back();
+        order.push_back(idx);
+        if (auto pendingIt = _pendingMerges.find(idx);
+                pendingIt != _pendingMerges.end()) {
+            toVisit.insert(toVisit.end(),
+                           pendingIt->second.begin(), pendingIt->second.end());
+        }
+    }
+
+    for (auto idxIt = order.rbegin(); idxIt != order.rend(); ++idxIt) {
+        if (auto pendingIt = _pendingMerges.find(*idxIt);
+                pendingIt != _pendingMerges.end()) {
+            auto& data = _data.at(*idxIt);
+            for (const std::size_t childIdx : pendingIt->second) {
+                auto childIt = _data.find(childIdx);
+                data.joinWith(childIt->second);
+                _data.erase(childIt);
+            }
+            _pendingMerges.erase(pendingIt);
+        }
+    }
 }
 
 //----------------------------------------------------------------------------//
-template<class KeyT, class RootDataT, class Comp>
-bool gdsu::DSUWithData<KeyT, RootDataT, Comp>::KeyPtrEq::operator()(
+template<class KeyT, class RootDataT, class Comp, class StatsT, class OffsetGroupT>
+bool gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT, OffsetGroupT>::KeyPtrComp::operator()(
         const KeyT* key1, const KeyT* key2) const {
-    return !(Comp()(*key1, *key2) || Comp()(*key2, *key1));
+    return Comp()(*key1, *key2);
 }
+
+#endif //DSU_WITH_DATA_DSU_WITH_DATA_HPP
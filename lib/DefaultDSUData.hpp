@@ -12,20 +12,23 @@ namespace gdsu {
 
     ////////////////////////////////////////////////////////////////////////////
     // class BaseRootDSUData<KeyT>
+    // Keeps root key only. Component size is maintained by DSU itself
+    // (getComponentSize), root data types do not track it.
     template<class KeyT>
     class BaseRootDSUData {
     public:
-        explicit BaseRootDSUData(const KeyT& key);
-        explicit BaseRootDSUData(KeyT&& key);
+        constexpr explicit BaseRootDSUData(const KeyT& key);
+        constexpr explicit BaseRootDSUData(KeyT&& key);
 
-        const KeyT& getKey() const;
-        [[nodiscard]] std::size_t getSize() const;
+        constexpr const KeyT& getKey() const;
     public:
         // Join with other root.
         // @param other - other data to join.
-        void joinWith(const BaseRootDSUData<KeyT>& other);
-    protected:
-        std::size_t _size;
+        constexpr void joinWith(const BaseRootDSUData<KeyT>& other);
+
+        // Detach erased element from the component.
+        // @param key - erased element key.
+        constexpr void detach(const KeyT& key);
     private:
         KeyT _key;
     };
@@ -34,29 +37,25 @@ namespace gdsu {
 ////////////////////////////////////////////////////////////////////////////////
 //----------------------------------------------------------------------------//
 template<class KeyT>
-gdsu::BaseRootDSUData<KeyT>::BaseRootDSUData(const KeyT& key)
-        : _key(key), _size(1) {}
+constexpr gdsu::BaseRootDSUData<KeyT>::BaseRootDSUData(const KeyT& key)
+        : _key(key) {}
 
 //----------------------------------------------------------------------------//
 template<class KeyT>
-gdsu::BaseRootDSUData<KeyT>::BaseRootDSUData(KeyT&& key)
-        : _key(std::move(key)), _size(1) {}
+constexpr gdsu::BaseRootDSUData<KeyT>::BaseRootDSUData(KeyT&& key)
+        : _key(std::move(key)) {}
 
 //----------------------------------------------------------------------------//
 template<class KeyT>
-void
-gdsu::BaseRootDSUData<KeyT>::joinWith(const BaseRootDSUData<KeyT>& other) {
-    this->_size += other._size;
-}
+constexpr void
+gdsu::BaseRootDSUData<KeyT>::joinWith(const BaseRootDSUData<KeyT>&) {}
 
 //----------------------------------------------------------------------------//
 template<class KeyT>
-std::size_t gdsu::BaseRootDSUData<KeyT>::getSize() const {
-    return _size;
-}
+constexpr void gdsu::BaseRootDSUData<KeyT>::detach(const KeyT&) {}
 
 //----------------------------------------------------------------------------//
 template<class KeyT>
-const KeyT &gdsu::BaseRootDSUData<KeyT>::getKey() const { return _key; }
+constexpr const KeyT &gdsu::BaseRootDSUData<KeyT>::getKey() const { return _key; }
 
 #endif //DSU_WITH_DATA_DEFAULTDSUDATA_HPP
@@ -0,0 +1,386 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_DEFERRED_DSU_WITH_DATA_HPP
+#define DSU_WITH_DATA_DEFERRED_DSU_WITH_DATA_HPP
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DSUWithData.hpp"
+#include "ParallelFor.hpp"
+
+namespace gdsu {
+    /**
+     * @brief class DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>
+     * Write-optimized DSU. Joins are only validated and appended to a
+     * buffer of index pairs. The buffer is applied in one batched pass in
+     * call order on explicit flush() or when a query needs consistent
+     * state, so roots and root data are the same as for DSUWithData.
+     * DSUWithData is not a public base: every query goes through this
+     * class and sees scheduled joins.
+     * @tparam KeyT
+     * @tparam RootDataT
+     * @tparam Comp
+     * @tparam StatsT
+     */
+    template<class KeyT,
+             class RootDataT = BaseRootDSUData<KeyT>,
+             class Comp = std::less<KeyT>,
+             class StatsT = NoComponentStats>
+    class DeferredDSUWithData
+            : protected DSUWithData<KeyT, RootDataT, Comp, StatsT> {
+    private:
+        using Base = DSUWithData<KeyT, RootDataT, Comp, StatsT>;
+        // Buffered index type. Half of size_t keeps pending pairs compact.
+        using PendingIdxT = std::uint32_t;
+
+        template<class DSUT>
+        friend class FilterKruskal;
+
+    public:
+
+        using typename Base::HotData;
+        using Base::lazyJoin;
+
+    public:
+
+        using Base::Base;
+
+        /**
+         * Schedule join of two components by keys.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         */
+        void join(const KeyT& key1, const KeyT& key2);
+
+        /**
+         * Schedule joins of keys pairs. Keys are resolved in parallel.
+         * Nothing is scheduled if some key is not found.
+         * @param keyPairs - pairs of keys to join.
+         * @param numberOfThreads - number of threads for keys resolving.
+         */
+        void joinAll(std::span<const std::pair<KeyT, KeyT>> keyPairs,
+                     std::size_t numberOfThreads = 1);
+
+        /**
+         * Schedule joins of keys 2 * i and 2 * i + 1 for every i. Keys are
+         * resolved in parallel. Nothing is scheduled if some key is not
+         * found.
+         * @param keys - keys, even number of them.
+         * @param numberOfThreads - number of threads for keys resolving.
+         */
+        void joinAll(std::span<const KeyT> keys,
+                     std::size_t numberOfThreads = 1);
+
+        /**
+         * Apply all scheduled joins.
+         */
+        void flush();
+
+        /**
+         * Erase key after applying scheduled joins.
+         * @param key - key to erase.
+         */
+        void erase(const KeyT& key);
+
+        /**
+         * Drop tombstones after applying scheduled joins.
+         */
+        void compact();
+
+        /**
+         * Renumber elements by components after applying scheduled joins.
+         * @param numberOfThreads - number of threads.
+         */
+        void reorder(std::size_t numberOfThreads = std::thread::hardware_concurrency());
+
+        /**
+         * Get number of scheduled joins.
+         * @return number of joins waiting for flush.
+         */
+        [[nodiscard]] std::size_t getNumberOfPendingJoins() const;
+
+        using Base::getNumberOfTombstones;
+        using Base::getNumberOfKeys;
+        using Base::forEachKey;
+
+        /**
+         * Check if two keys are of the same component.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @return `true if key1 and key2 are of the same component.
+         */
+        bool inSameComponent(const KeyT& key1, const KeyT& key2) const;
+
+        /**
+         * Get component size.
+         * @param key - key.
+         * @return number of elements in the same component as key.
+         */
+        std::size_t getComponentSize(const KeyT& key) const;
+
+        /**
+         * Get number of components in the DSU.
+         * @return number of components.
+         */
+        [[nodiscard]] std::size_t getNumberOfComponents() const;
+
+        /**
+         * Root data by key.
+         * @param key - key to search.
+         * @return rootDataOfTheComponent.
+         */
+        const RootDataT& getRootData(const KeyT& key) const;
+
+        /**
+         * Hot part of root data by key.
+         * @param key - key to search.
+         * @return hot data of the component.
+         */
+        const HotData& getRootHotData(const KeyT& key) const
+        requires (!std::is_same_v<HotData, NoHotData>);
+
+        /**
+         * Components statistics maintained during joins.
+         * @return statistics policy object.
+         */
+        const StatsT& getComponentStats() const
+        requires (!std::is_same_v<StatsT, NoComponentStats>);
+
+    private:
+
+        /**
+         * Schedule joins of keys pairs.
+         * @param numberOfPairs - number of pairs.
+         * @param numberOfThreads - number of threads for keys resolving.
+         * @param getPair - callable returning i-th pair of keys.
+         */
+        template<class GetPairT>
+        void _joinAll(std::size_t numberOfPairs,
+                      std::size_t numberOfThreads,
+                      GetPairT getPair);
+
+        /**
+         * Apply scheduled joins before a query. Does nothing if there are
+         * no scheduled joins, so is safe for const objects.
+         */
+        void _flushForQuery() const;
+
+    private:
+        // How many pairs ahead parents are prefetched during flush.
+        constexpr static std::size_t _prefetchDistance = 8;
+
+        // Scheduled joins
+        mutable std::vector<std::pair<PendingIdxT, PendingIdxT>> _pending;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::join(
+        const KeyT& key1, const KeyT& key2) {
+    const std::size_t idx1 = this->_getIdxByKey(key1);
+    const std::size_t idx2 = this->_getIdxByKey(key2);
+
+    if (constexpr auto maxIdx = std::numeric_limits<PendingIdxT>::max();
+            idx1 > maxIdx || idx2 > maxIdx) {
+        // Can not be buffered compactly.
+        flush();
+        Base::join(key1, key2);
+        return;
+    }
+
+    _pending.emplace_back(static_cast<PendingIdxT>(idx1),
+                          static_cast<PendingIdxT>(idx2));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::joinAll(
+        std::span<const std::pair<KeyT, KeyT>> keyPairs,
+        std::size_t numberOfThreads) {
+    _joinAll(keyPairs.size(), numberOfThreads,
+             [&](std::size_t i) -> const std::pair<KeyT, KeyT>& {
+                 return keyPairs[i];
+             });
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::joinAll(
+        std::span<const KeyT> keys,
+        std::size_t numberOfThreads) {
+    if (keys.size() % 2 != 0) {
+        throw std::invalid_argument("Odd number of keys.");
+    }
+    _joinAll(keys.size() / 2, numberOfThreads,
+             [&](std::size_t i) {
+                 return std::pair<const KeyT&, const KeyT&>(keys[2 * i],
+                                                            keys[2 * i + 1]);
+             });
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class GetPairT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::_joinAll(
+        std::size_t numberOfPairs,
+        std::size_t numberOfThreads,
+        GetPairT getPair) {
+    if (this->_nodes.size() > std::numeric_limits<PendingIdxT>::max()) {
+        // Can not be buffered compactly.
+        for (std::size_t i = 0; i < numberOfPairs; ++i) {
+            const auto& [key1, key2] = getPair(i);
+            join(key1, key2);
+        }
+        return;
+    }
+
+    const std::size_t oldSize = _pending.size();
+    _pending.resize(oldSize + numberOfPairs);
+    try {
+        parallelFor(numberOfPairs, numberOfThreads,
+                    [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+            for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+                const auto& [key1, key2] = getPair(i);
+                const std::size_t idx1 = this->_getIdxByKey(key1);
+                const std::size_t idx2 = this->_getIdxByKey(key2);
+                _pending[oldSize + i] = {static_cast<PendingIdxT>(idx1),
+                                         static_cast<PendingIdxT>(idx2)};
+            }
+        });
+    } catch (...) {
+        _pending.resize(oldSize);
+        throw;
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::flush() {
+    if (_pending.empty()) {
+        return;
+    }
+
+    // Call order is kept: it decides roots and root data joins order.
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (i + _prefetchDistance < _pending.size()) {
+            const auto& [aheadIdx1, aheadIdx2] = _pending[i + _prefetchDistance];
+            __builtin_prefetch(this->_nodes.data() + aheadIdx1);
+            __builtin_prefetch(this->_nodes.data() + aheadIdx2);
+        }
+#endif
+        const auto& [idx1, idx2] = _pending[i];
+        const std::size_t rootIdx1 = this->_getRootIdxByIndex(idx1);
+        const std::size_t rootIdx2 = this->_getRootIdxByIndex(idx2);
+        if (rootIdx1 != rootIdx2) {
+            this->_join(rootIdx1, rootIdx2);
+        }
+    }
+
+    _pending.clear();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::erase(
+        const KeyT& key) {
+    flush();
+    Base::erase(key);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::compact() {
+    flush();
+    Base::compact();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::reorder(
+        std::size_t numberOfThreads) {
+    flush();
+    Base::reorder(numberOfThreads);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+std::size_t gdsu::DeferredDSUWithData<
+        KeyT, RootDataT, Comp, StatsT>::getNumberOfPendingJoins() const {
+    return _pending.size();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+bool gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::inSameComponent(
+        const KeyT& key1, const KeyT& key2) const {
+    _flushForQuery();
+    return Base::inSameComponent(key1, key2);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+std::size_t
+gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::getComponentSize(
+        const KeyT& key) const {
+    _flushForQuery();
+    return Base::getComponentSize(key);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+std::size_t gdsu::DeferredDSUWithData<
+        KeyT, RootDataT, Comp, StatsT>::getNumberOfComponents() const {
+    _flushForQuery();
+    return Base::getNumberOfComponents();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+const RootDataT&
+gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::getRootData(
+        const KeyT& key) const {
+    _flushForQuery();
+    return Base::getRootData(key);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+auto
+gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::getRootHotData(
+        const KeyT& key) const -> const HotData&
+requires (!std::is_same_v<HotData, NoHotData>) {
+    _flushForQuery();
+    return Base::getRootHotData(key);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+const StatsT&
+gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::getComponentStats() const
+requires (!std::is_same_v<StatsT, NoComponentStats>) {
+    _flushForQuery();
+    return Base::getComponentStats();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+void
+gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>::_flushForQuery() const {
+    if (!_pending.empty()) {
+        // Only non-const objects can have scheduled joins.
+        const_cast<DeferredDSUWithData*>(this)->flush();
+    }
+}
+
+#endif //DSU_WITH_DATA_DEFERRED_DSU_WITH_DATA_HPP
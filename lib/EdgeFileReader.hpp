@@ -0,0 +1,621 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_EDGE_FILE_READER_HPP
+#define DSU_WITH_DATA_EDGE_FILE_READER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DeferredDSUWithData.hpp"
+#include "ParallelFor.hpp"
+
+namespace gdsu {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // enum class EdgeFileFormat
+    // Text: one edge per line, two integer keys separated by whitespace,
+    // the rest of the line is ignored. Empty lines and lines starting with
+    // '#' or '%' are skipped.
+    // Binary: pairs of native endian keys of KeyT size without separators.
+    enum class EdgeFileFormat {
+        Text,
+        Binary
+    };
+
+    /**
+     * @brief class MappedFile
+     * Read-only memory mapping of a whole file.
+     */
+    class MappedFile {
+    public:
+
+        /**
+         * Map file. Throws std::system_error on failure.
+         * @param path - file path.
+         */
+        explicit MappedFile(const std::string& path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        ~MappedFile();
+
+        /**
+         * Get file contents.
+         * @return view of the mapped memory.
+         */
+        [[nodiscard]] std::string_view getView() const;
+
+    private:
+        // Mapped memory, nullptr for empty files.
+        const char* _data{nullptr};
+        // File size
+        std::size_t _size{0};
+    };
+
+    /**
+     * @brief class EdgeFileReader<KeyT>
+     * Edge file parser working on memory mapped file. Text files are
+     * streamed in line aligned batches, every batch is split into chunks
+     * parsed in parallel with std::from_chars while the previous batch is
+     * consumed, so there are no per line allocations and at most two
+     * batches are in memory. Binary files are viewed in place.
+     * @tparam KeyT - integral key type.
+     */
+    template<std::integral KeyT>
+    class EdgeFileReader {
+    public:
+        using Edge = std::pair<KeyT, KeyT>;
+
+    public:
+
+        /**
+         * Edge file reader constructor.
+         * @param path - file path.
+         * @param format - file format.
+         */
+        EdgeFileReader(const std::string& path, EdgeFileFormat format);
+
+        /**
+         * Parse all edges. Throws std::runtime_error on malformed input.
+         * @param numberOfThreads - number of parsing threads.
+         * @return edges in file order.
+         */
+        [[nodiscard]] std::vector<Edge> readEdges(std::size_t numberOfThreads) const;
+
+        /**
+         * Pass edges to consumer batch by batch in file order. Edge i of a
+         * batch is formed by keys 2 * i and 2 * i + 1. Binary batches are
+         * views of the mapped file, text batches are valid until consumer
+         * returns. Throws std::runtime_error on malformed input.
+         * @tparam ConsumerT - callable with std::span<const KeyT>.
+         * @param numberOfThreads - number of parsing threads.
+         * @param batchBytes - approximate number of file bytes per batch.
+         * @param consumer - batches consumer.
+         */
+        template<class ConsumerT>
+        void forEachBatch(std::size_t numberOfThreads,
+                          std::size_t batchBytes,
+                          ConsumerT&& consumer) const;
+
+        /**
+         * View keys of binary file without copying. Edge i is formed by
+         * keys 2 * i and 2 * i + 1.
+         * @return keys view.
+         */
+        [[nodiscard]] std::span<const KeyT> viewBinaryKeys() const;
+
+    private:
+
+        /**
+         * Parse text lines in [begin, end) split into line aligned chunks
+         * in parallel.
+         * @param begin - text beginning offset, at line start.
+         * @param end - text ending offset, after line end.
+         * @param numberOfThreads - number of parsing threads.
+         * @param chunkKeys - output keys for every chunk.
+         */
+        void _parseTextInChunks(std::size_t begin,
+                                std::size_t end,
+                                std::size_t numberOfThreads,
+                                std::vector<std::vector<KeyT>>& chunkKeys) const;
+
+        /**
+         * Parse text lines in [begin, end).
+         * @param begin - chunk beginning, at line start.
+         * @param end - chunk ending, after line end.
+         * @param keys - output keys, two per edge.
+         */
+        static void _parseText(const char* begin,
+                               const char* end,
+                               std::vector<KeyT>& keys);
+
+        /**
+         * Move position to the beginning of the next line.
+         * @param pos - position.
+         * @return next line beginning or text end.
+         */
+        [[nodiscard]] std::size_t _nextLineStart(std::size_t pos) const;
+
+    private:
+        // Number of chunks per thread for text parsing load balancing.
+        constexpr static std::size_t _chunksPerThread = 4;
+        // Batch size for reading all edges.
+        constexpr static std::size_t _readBatchBytes = std::size_t(1) << 24;
+
+        MappedFile _file;
+        EdgeFileFormat _format;
+    };
+
+    /**
+     * @brief struct EdgesDSU<KeyT, RootDataT, StatsT>
+     * DSU built over edges with number of edges.
+     * @tparam KeyT
+     * @tparam RootDataT
+     * @tparam StatsT
+     */
+    template<std::integral KeyT, class RootDataT, class StatsT>
+    struct EdgesDSU {
+        // DSU with all edges joined
+        DeferredDSUWithData<KeyT, RootDataT, std::less<KeyT>, StatsT> dsu;
+        // Number of edges
+        std::size_t numberOfEdges;
+    };
+
+    /**
+     * @brief class EdgesDSUBuilder<KeyT, RootDataT, StatsT>
+     * Builds deferred DSU in two passes over batches of edges. First pass
+     * collects sorted unique endpoints, unsorted keys are kept not more
+     * than sorted ones, so memory is bounded by number of unique keys and
+     * batch size. Second pass schedules joins of every batch in parallel
+     * and flushes them. Edges are never gathered in one array.
+     * @tparam KeyT
+     * @tparam RootDataT
+     * @tparam StatsT
+     */
+    template<std::integral KeyT, class RootDataT, class StatsT>
+    class EdgesDSUBuilder {
+    public:
+
+        /**
+         * Build DSU.
+         * @tparam ForEachBatchT - callable passing every batch to its
+         * argument, batch is std::span<const std::pair<KeyT, KeyT>> or
+         * std::span<const KeyT> of pairs of keys. Called twice.
+         * @param forEachBatch - batches source.
+         * @param numberOfThreads - number of threads.
+         * @return DSU with all edges joined and number of edges.
+         */
+        template<class ForEachBatchT>
+        static EdgesDSU<KeyT, RootDataT, StatsT>
+        run(ForEachBatchT forEachBatch, std::size_t numberOfThreads);
+
+    private:
+
+        /**
+         * Append endpoints of edges.
+         * @param batch - edges.
+         * @param keys - keys to append to.
+         */
+        static void _appendKeys(std::span<const std::pair<KeyT, KeyT>> batch,
+                                std::vector<KeyT>& keys);
+
+        /**
+         * Append endpoints of edges.
+         * @param batch - pairs of keys.
+         * @param keys - keys to append to.
+         */
+        static void _appendKeys(std::span<const KeyT> batch,
+                                std::vector<KeyT>& keys);
+
+        /**
+         * Sort keys and remove repeats. Tail is sorted in parallel chunks,
+         * then chunks are merged pairwise with sorted prefix.
+         * @param keys - keys.
+         * @param sortedSize - size of sorted unique prefix.
+         * @param numberOfThreads - number of threads.
+         */
+        static void _sortUniqueTail(std::vector<KeyT>& keys,
+                                    std::size_t sortedSize,
+                                    std::size_t numberOfThreads);
+
+    private:
+        // Unsorted keys are always allowed to grow up to this size.
+        constexpr static std::size_t _minUnsortedKeys = std::size_t(1) << 20;
+    };
+
+    /**
+     * Build deferred DSU over all edges endpoints and join edges in
+     * batches.
+     * @tparam RootDataT - root data type.
+     * @tparam StatsT - statistics policy.
+     * @param edges - edges.
+     * @param numberOfThreads - number of threads for keys collection and
+     * resolving.
+     * @param batchSize - number of joins scheduled between flushes.
+     * @return DSU with all edges joined.
+     */
+    template<class RootDataT, class StatsT, std::integral KeyT>
+    DeferredDSUWithData<KeyT, RootDataT, std::less<KeyT>, StatsT>
+    buildDSUFromEdges(const std::vector<std::pair<KeyT, KeyT>>& edges,
+                      std::size_t numberOfThreads,
+                      std::size_t batchSize = std::size_t(1) << 20);
+
+    /**
+     * Build deferred DSU over edges of file streamed in batches. Every
+     * batch is joined and flushed right after parsing.
+     * @tparam RootDataT - root data type.
+     * @tparam StatsT - statistics policy.
+     * @param reader - edge file reader.
+     * @param numberOfThreads - number of threads for parsing, keys
+     * collection and resolving.
+     * @param batchBytes - approximate number of file bytes per batch.
+     * @return DSU with all edges joined and number of edges.
+     */
+    template<class RootDataT, class StatsT, std::integral KeyT>
+    EdgesDSU<KeyT, RootDataT, StatsT>
+    buildDSUFromFile(const EdgeFileReader<KeyT>& reader,
+                     std::size_t numberOfThreads,
+                     std::size_t batchBytes = std::size_t(1) << 24);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+inline gdsu::MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat fileStat{};
+    if (::fstat(fd, &fileStat) != 0) {
+        const int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), path);
+    }
+    _size = static_cast<std::size_t>(fileStat.st_size);
+    if (_size != 0) {
+        void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+        ::madvise(mapped, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+}
+
+//----------------------------------------------------------------------------//
+inline gdsu::MappedFile::MappedFile(MappedFile&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)) {}
+
+//----------------------------------------------------------------------------//
+inline auto gdsu::MappedFile::operator=(MappedFile&& other) noexcept
+        -> MappedFile& {
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    return *this;
+}
+
+//----------------------------------------------------------------------------//
+inline gdsu::MappedFile::~MappedFile() {
+    if (_data != nullptr) {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+}
+
+//----------------------------------------------------------------------------//
+inline std::string_view gdsu::MappedFile::getView() const {
+    return {_data, _size};
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+gdsu::EdgeFileReader<KeyT>::EdgeFileReader(const std::string& path,
+                                           EdgeFileFormat format)
+        : _file(path), _format(format) {
+    if (_format == EdgeFileFormat::Binary
+            && _file.getView().size() % (2 * sizeof(KeyT)) != 0) {
+        throw std::runtime_error("Binary edge file size is not a multiple "
+                                 "of edge size.");
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+auto gdsu::EdgeFileReader<KeyT>::readEdges(std::size_t numberOfThreads) const
+        -> std::vector<Edge> {
+    auto edges = std::vector<Edge>();
+    if (_format == EdgeFileFormat::Binary) {
+        edges.reserve(viewBinaryKeys().size() / 2);
+    }
+    forEachBatch(numberOfThreads, _readBatchBytes,
+                 [&](std::span<const KeyT> keys) {
+        for (std::size_t i = 0; i < keys.size(); i += 2) {
+            edges.emplace_back(keys[i], keys[i + 1]);
+        }
+    });
+    return edges;
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+template<class ConsumerT>
+void gdsu::EdgeFileReader<KeyT>::forEachBatch(std::size_t numberOfThreads,
+                                              std::size_t batchBytes,
+                                              ConsumerT&& consumer) const {
+    numberOfThreads = std::max<std::size_t>(numberOfThreads, 1);
+    batchBytes = std::max<std::size_t>(batchBytes, 1);
+
+    if (_format == EdgeFileFormat::Binary) {
+        const auto keys = viewBinaryKeys();
+        const std::size_t batchKeys =
+                2 * std::max<std::size_t>(batchBytes / (2 * sizeof(KeyT)), 1);
+        for (std::size_t batchBegin = 0; batchBegin < keys.size();
+             batchBegin += batchKeys) {
+            consumer(keys.subspan(batchBegin,
+                                  std::min(batchKeys, keys.size() - batchBegin)));
+        }
+        return;
+    }
+
+    const std::size_t textSize = _file.getView().size();
+    const std::size_t numberOfChunks = numberOfThreads * _chunksPerThread;
+    auto currentChunkKeys = std::vector<std::vector<KeyT>>(numberOfChunks);
+    auto nextChunkKeys = std::vector<std::vector<KeyT>>(numberOfChunks);
+
+    std::size_t batchBegin = 0;
+    std::size_t batchEnd = _nextLineStart(std::min(batchBytes, textSize));
+    _parseTextInChunks(batchBegin, batchEnd, numberOfThreads, currentChunkKeys);
+    while (batchBegin != textSize) {
+        batchBegin = batchEnd;
+        batchEnd = _nextLineStart(std::min(batchBegin + batchBytes, textSize));
+        // Next batch is parsed while the current one is consumed.
+        auto nextParsed = std::async(
+                std::launch::async,
+                [&, begin = batchBegin, end = batchEnd] {
+                    _parseTextInChunks(begin, end, numberOfThreads, nextChunkKeys);
+                });
+        for (const auto& keys : currentChunkKeys) {
+            if (!keys.empty()) {
+                consumer(std::span<const KeyT>(keys));
+            }
+        }
+        nextParsed.get();
+        std::swap(currentChunkKeys, nextChunkKeys);
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+std::span<const KeyT> gdsu::EdgeFileReader<KeyT>::viewBinaryKeys() const {
+    if (_format != EdgeFileFormat::Binary) {
+        throw std::logic_error("Keys view is available for binary files only.");
+    }
+    const auto bytes = _file.getView();
+    // Mapping is page aligned, so keys are properly aligned.
+    return {reinterpret_cast<const KeyT*>(bytes.data()),
+            bytes.size() / sizeof(KeyT)};
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+void gdsu::EdgeFileReader<KeyT>::_parseTextInChunks(
+        std::size_t begin,
+        std::size_t end,
+        std::size_t numberOfThreads,
+        std::vector<std::vector<KeyT>>& chunkKeys) const {
+    const auto text = _file.getView();
+    const std::size_t numberOfChunks = chunkKeys.size();
+    auto chunkStarts = std::vector<std::size_t>(numberOfChunks + 1, begin);
+    for (std::size_t i = 1; i < numberOfChunks; ++i) {
+        chunkStarts[i] = std::clamp(
+                _nextLineStart(begin + (end - begin) * i / numberOfChunks),
+                chunkStarts[i - 1], end);
+    }
+    chunkStarts.back() = end;
+
+    parallelFor(numberOfChunks, numberOfThreads,
+                [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            chunkKeys[i].clear();
+            _parseText(text.data() + chunkStarts[i],
+                       text.data() + chunkStarts[i + 1],
+                       chunkKeys[i]);
+        }
+    });
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+void gdsu::EdgeFileReader<KeyT>::_parseText(const char* begin,
+                                            const char* end,
+                                            std::vector<KeyT>& keys) {
+    const auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+
+    for (const char* pos = begin; pos < end;) {
+        const char* lineEnd = std::find(pos, end, '\n');
+        while (pos < lineEnd && isSpace(*pos)) {
+            ++pos;
+        }
+        if (pos != lineEnd && *pos != '#' && *pos != '%') {
+            KeyT from;
+            KeyT to;
+            auto [fromEnd, fromErr] = std::from_chars(pos, lineEnd, from);
+            pos = fromEnd;
+            while (pos < lineEnd && isSpace(*pos)) {
+                ++pos;
+            }
+            auto [_, toErr] = std::from_chars(pos, lineEnd, to);
+            if (fromErr != std::errc() || toErr != std::errc()) {
+                throw std::runtime_error("Malformed edge line.");
+            }
+            keys.push_back(from);
+            keys.push_back(to);
+        }
+        pos = lineEnd == end ? end : lineEnd + 1;
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT>
+std::size_t gdsu::EdgeFileReader<KeyT>::_nextLineStart(std::size_t pos) const {
+    const auto text = _file.getView();
+    if (pos == 0) {
+        return 0;
+    }
+    if (const auto newLinePos = text.find('\n', pos - 1);
+            newLinePos != std::string_view::npos) {
+        return newLinePos + 1;
+    }
+    return text.size();
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT, class RootDataT, class StatsT>
+template<class ForEachBatchT>
+auto gdsu::EdgesDSUBuilder<KeyT, RootDataT, StatsT>::run(
+        ForEachBatchT forEachBatch,
+        std::size_t numberOfThreads) -> EdgesDSU<KeyT, RootDataT, StatsT> {
+    numberOfThreads = std::max<std::size_t>(numberOfThreads, 1);
+
+    auto keys = std::vector<KeyT>();
+    std::size_t sortedSize = 0;
+    std::size_t numberOfEdges = 0;
+    forEachBatch([&](auto batch) {
+        const std::size_t oldSize = keys.size();
+        _appendKeys(batch, keys);
+        numberOfEdges += (keys.size() - oldSize) / 2;
+        if (keys.size() - sortedSize > std::max(sortedSize, _minUnsortedKeys)) {
+            _sortUniqueTail(keys, sortedSize, numberOfThreads);
+            sortedSize = keys.size();
+        }
+    });
+    _sortUniqueTail(keys, sortedSize, numberOfThreads);
+
+    auto dsu = DeferredDSUWithData<KeyT, RootDataT, std::less<KeyT>, StatsT>(
+            std::move(keys), std::bool_constant<true>());
+    // Keys are kept by DSU only.
+    keys = std::vector<KeyT>();
+
+    forEachBatch([&](auto batch) {
+        dsu.joinAll(batch, numberOfThreads);
+        dsu.flush();
+    });
+
+    return {std::move(dsu), numberOfEdges};
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT, class RootDataT, class StatsT>
+void gdsu::EdgesDSUBuilder<KeyT, RootDataT, StatsT>::_appendKeys(
+        std::span<const std::pair<KeyT, KeyT>> batch,
+        std::vector<KeyT>& keys) {
+    for (const auto& [from, to] : batch) {
+        keys.push_back(from);
+        keys.push_back(to);
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT, class RootDataT, class StatsT>
+void gdsu::EdgesDSUBuilder<KeyT, RootDataT, StatsT>::_appendKeys(
+        std::span<const KeyT> batch,
+        std::vector<KeyT>& keys) {
+    keys.insert(keys.end(), batch.begin(), batch.end());
+}
+
+//----------------------------------------------------------------------------//
+template<std::integral KeyT, class RootDataT, class StatsT>
+void gdsu::EdgesDSUBuilder<KeyT, RootDataT, StatsT>::_sortUniqueTail(
+        std::vector<KeyT>& keys,
+        std::size_t sortedSize,
+        std::size_t numberOfThreads) {
+    // Run 0 is the sorted prefix, the rest are tail chunks.
+    const std::size_t numberOfRuns = numberOfThreads + 1;
+    auto bounds = std::vector<std::size_t>(numberOfRuns + 1);
+    for (std::size_t i = 0; i <= numberOfThreads; ++i) {
+        bounds[i + 1] = sortedSize + (keys.size() - sortedSize) * i / numberOfThreads;
+    }
+    parallelFor(numberOfThreads, numberOfThreads,
+                [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t run = chunkBegin + 1; run < chunkEnd + 1; ++run) {
+            std::sort(keys.begin() + bounds[run], keys.begin() + bounds[run + 1]);
+        }
+    });
+    for (std::size_t width = 1; width < numberOfRuns; width *= 2) {
+        const std::size_t numberOfMerges =
+                (numberOfRuns + 2 * width - 1) / (2 * width);
+        parallelFor(numberOfMerges, numberOfThreads,
+                    [&](std::size_t mergeBegin, std::size_t mergeEnd) {
+            for (std::size_t merge = mergeBegin; merge < mergeEnd; ++merge) {
+                const std::size_t first = 2 * width * merge;
+                const std::size_t middle = std::min(first + width, numberOfRuns);
+                const std::size_t last = std::min(first + 2 * width, numberOfRuns);
+                std::inplace_merge(keys.begin() + bounds[first],
+                                   keys.begin() + bounds[middle],
+                                   keys.begin() + bounds[last]);
+            }
+        });
+    }
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+//----------------------------------------------------------------------------//
+template<class RootDataT, class StatsT, std::integral KeyT>
+gdsu::DeferredDSUWithData<KeyT, RootDataT, std::less<KeyT>, StatsT>
+gdsu::buildDSUFromEdges(const std::vector<std::pair<KeyT, KeyT>>& edges,
+                        std::size_t numberOfThreads,
+                        std::size_t batchSize) {
+    batchSize = std::max<std::size_t>(batchSize, 1);
+    const auto forEachBatch = [&](auto&& consumer) {
+        const auto edgesView = std::span<const std::pair<KeyT, KeyT>>(edges);
+        for (std::size_t batchBegin = 0; batchBegin < edges.size();
+             batchBegin += batchSize) {
+            consumer(edgesView.subspan(
+                    batchBegin, std::min(batchSize, edges.size() - batchBegin)));
+        }
+    };
+    return EdgesDSUBuilder<KeyT, RootDataT, StatsT>::run(
+            forEachBatch, numberOfThreads).dsu;
+}
+
+//----------------------------------------------------------------------------//
+template<class RootDataT, class StatsT, std::integral KeyT>
+gdsu::EdgesDSU<KeyT, RootDataT, StatsT>
+gdsu::buildDSUFromFile(const EdgeFileReader<KeyT>& reader,
+                       std::size_t numberOfThreads,
+                       std::size_t batchBytes) {
+    const auto forEachBatch = [&](auto&& consumer) {
+        reader.forEachBatch(numberOfThreads, batchBytes, consumer);
+    };
+    return EdgesDSUBuilder<KeyT, RootDataT, StatsT>::run(
+            forEachBatch, numberOfThreads);
+}
+
+#endif //DSU_WITH_DATA_EDGE_FILE_READER_HPP
@@ -0,0 +1,287 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_EYTZINGER_KEY_INDEX_HPP
+#define DSU_WITH_DATA_EYTZINGER_KEY_INDEX_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace gdsu {
+    /**
+     * @brief class EytzingerKeyIndex<KeyT, Comp>
+     * Read-optimized mapping from keys to DSU indices. Keys are
+     * stored in one flat array in Eytzinger (BFS) order, so a lookup is a
+     * branchless descent touching O(log n) cache lines, the next ones being
+     * prefetched while the current level is compared.
+     * @tparam KeyT - key type.
+     * @tparam Comp - keys comparator.
+     */
+    template<class KeyT, class Comp = std::less<KeyT>>
+    class EytzingerKeyIndex {
+    public:
+        // Value returned for missing keys.
+        constexpr static std::size_t npos =
+                std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Empty index constructor.
+         */
+        EytzingerKeyIndex() = default;
+
+        /**
+         * Index constructor. Works in O(n).
+         * @param sorted - pairs of key pointer and index, sorted by keys
+         * with Comp. Keys must not repeat.
+         */
+        explicit EytzingerKeyIndex(
+                const std::vector<std::pair<const KeyT*, std::size_t>>& sorted);
+
+        /**
+         * Find index by key.
+         * @param key - key to search.
+         * @return index if key was found, npos otherwise.
+         */
+        [[nodiscard]] std::size_t find(const KeyT& key) const;
+
+        /**
+         * Erase key. The slot is kept as a tombstone until compaction.
+         * @param key - key to erase.
+         * @return erased key index, npos if key was not found.
+         */
+        std::size_t erase(const KeyT& key);
+
+        /**
+         * Build index without tombstones with remapped indices. Works in
+         * O(n).
+         * @param newIndices - new index for every old index, npos to drop
+         * key.
+         * @return new index.
+         */
+        [[nodiscard]] EytzingerKeyIndex
+        compacted(const std::vector<std::size_t>& newIndices) const;
+
+        /**
+         * Remap indices in place. Keys are not moved. Works in O(n).
+         * @param newIndices - new index for every old index.
+         */
+        void renumber(const std::vector<std::size_t>& newIndices);
+
+        /**
+         * Get number of key slots in the index, including erased.
+         * @return number of keys.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * Call function for every not erased key in ascending order. Works
+         * in O(n).
+         * @tparam FunctionT - callable with (const KeyT&).
+         * @param function - function to call.
+         */
+        template<class FunctionT>
+        void forEach(FunctionT function) const;
+
+    private:
+
+        /**
+         * Find Eytzinger position by key.
+         * @param key - key to search.
+         * @return position (1-based) if key is stored, 0 otherwise.
+         */
+        [[nodiscard]] std::size_t _findPosition(const KeyT& key) const;
+
+        /**
+         * Collect remapped live keys of the subtree in sorted order.
+         * @param k - subtree root Eytzinger position (1-based).
+         * @param newIndices - new index for every old index.
+         * @param sorted - collected keys pointers and indices.
+         */
+        void _collectSorted(
+                std::size_t k,
+                const std::vector<std::size_t>& newIndices,
+                std::vector<std::pair<const KeyT*, std::size_t>>& sorted) const;
+
+        /**
+         * Fill Eytzinger position to sorted position mapping in-order.
+         * @param order - mapping to fill.
+         * @param sortedIdx - next sorted position to place.
+         * @param k - current Eytzinger position (1-based).
+         * @return next sorted position to place.
+         */
+        static std::size_t _fillOrder(std::vector<std::size_t>& order,
+                                      std::size_t sortedIdx,
+                                      std::size_t k);
+
+        /**
+         * Prefetch subtree of position k several levels below.
+         * @param k - current Eytzinger position (1-based).
+         */
+        void _prefetchDescendants(std::size_t k) const;
+
+    private:
+        // Number of keys which fit into one cache line (power of two).
+        constexpr static std::size_t _keysPerLine =
+                std::bit_floor(std::max<std::size_t>(64 / sizeof(KeyT), 2));
+
+        // Keys in Eytzinger order. Position k (1-based) is stored at k - 1.
+        std::vector<KeyT> _keys;
+        // Indices in the same order as keys.
+        std::vector<std::size_t> _indices;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+gdsu::EytzingerKeyIndex<KeyT, Comp>::EytzingerKeyIndex(
+        const std::vector<std::pair<const KeyT*, std::size_t>>& sorted) {
+    auto order = std::vector<std::size_t>(sorted.size() + 1);
+    [[maybe_unused]] const std::size_t placed = _fillOrder(order, 0, 1);
+    assert(placed == sorted.size());
+
+    _keys.reserve(sorted.size());
+    _indices.reserve(sorted.size());
+    for (std::size_t k = 1; k <= sorted.size(); ++k) {
+        const auto& [keyPtr, idx] = sorted[order[k]];
+        _keys.push_back(*keyPtr);
+        _indices.push_back(idx);
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t
+gdsu::EytzingerKeyIndex<KeyT, Comp>::find(const KeyT& key) const {
+    const std::size_t k = _findPosition(key);
+    return k == 0 ? npos : _indices[k - 1];
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::EytzingerKeyIndex<KeyT, Comp>::erase(const KeyT& key) {
+    const std::size_t k = _findPosition(key);
+    if (k == 0) {
+        return npos;
+    }
+    return std::exchange(_indices[k - 1], npos);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+auto gdsu::EytzingerKeyIndex<KeyT, Comp>::compacted(
+        const std::vector<std::size_t>& newIndices) const -> EytzingerKeyIndex {
+    auto sorted = std::vector<std::pair<const KeyT*, std::size_t>>();
+    sorted.reserve(_keys.size());
+    _collectSorted(1, newIndices, sorted);
+    return EytzingerKeyIndex(sorted);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::EytzingerKeyIndex<KeyT, Comp>::renumber(
+        const std::vector<std::size_t>& newIndices) {
+    for (auto& idx : _indices) {
+        if (idx != npos) {
+            idx = newIndices[idx];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t
+gdsu::EytzingerKeyIndex<KeyT, Comp>::_findPosition(const KeyT& key) const {
+    const std::size_t n = _keys.size();
+    std::size_t k = 1;
+    while (k <= n) {
+        _prefetchDescendants(k);
+        k = 2 * k + static_cast<std::size_t>(Comp()(_keys[k - 1], key));
+    }
+    // Cancel right turns made after the last left one.
+    k >>= std::countr_one(k) + 1;
+    if (k == 0 || Comp()(key, _keys[k - 1])) {
+        return 0;
+    }
+    return k;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::EytzingerKeyIndex<KeyT, Comp>::size() const {
+    return _keys.size();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+template<class FunctionT>
+void gdsu::EytzingerKeyIndex<KeyT, Comp>::forEach(FunctionT function) const {
+    const std::size_t n = _keys.size();
+    if (n == 0) {
+        return;
+    }
+    // In-order traversal: leftmost position first, then successors.
+    std::size_t k = std::bit_floor(n);
+    while (k != 0) {
+        if (_indices[k - 1] != npos) {
+            function(_keys[k - 1]);
+        }
+        if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) {
+                k *= 2;
+            }
+        } else {
+            k >>= std::countr_one(k) + 1;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::EytzingerKeyIndex<KeyT, Comp>::_fillOrder(
+        std::vector<std::size_t>& order, std::size_t sortedIdx, std::size_t k) {
+    if (k < order.size()) {
+        sortedIdx = _fillOrder(order, sortedIdx, 2 * k);
+        order[k] = sortedIdx++;
+        sortedIdx = _fillOrder(order, sortedIdx, 2 * k + 1);
+    }
+    return sortedIdx;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::EytzingerKeyIndex<KeyT, Comp>::_collectSorted(
+        std::size_t k,
+        const std::vector<std::size_t>& newIndices,
+        std::vector<std::pair<const KeyT*, std::size_t>>& sorted) const {
+    if (k <= _keys.size()) {
+        _collectSorted(2 * k, newIndices, sorted);
+        if (const std::size_t oldIdx = _indices[k - 1]; oldIdx != npos) {
+            if (const std::size_t newIdx = newIndices[oldIdx]; newIdx != npos) {
+                sorted.emplace_back(&_keys[k - 1], newIdx);
+            }
+        }
+        _collectSorted(2 * k + 1, newIndices, sorted);
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::EytzingerKeyIndex<KeyT, Comp>::_prefetchDescendants(
+        std::size_t k) const {
+#if defined(__GNUC__) || defined(__clang__)
+    if (const std::size_t ahead = k * _keysPerLine; ahead <= _keys.size()) {
+        __builtin_prefetch(_keys.data() + ahead - 1);
+    }
+#endif
+}
+
+#endif //DSU_WITH_DATA_EYTZINGER_KEY_INDEX_HPP
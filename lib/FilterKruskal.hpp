@@ -0,0 +1,343 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_FILTER_KRUSKAL_HPP
+#define DSU_WITH_DATA_FILTER_KRUSKAL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "DSUWithData.hpp"
+#include "DeferredDSUWithData.hpp"
+#include "ParallelFor.hpp"
+
+namespace gdsu {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct WeightedEdge<KeyT, WeightT>
+    template<class KeyT, class WeightT>
+    struct WeightedEdge {
+        KeyT from;
+        KeyT to;
+        WeightT weight;
+    };
+
+    /**
+     * @brief class FilterKruskal<DSUWithData<KeyT, RootDataT, Comp, StatsT>>
+     * Minimum spanning forest by filter-Kruskal. Edges are partitioned
+     * around a pivot weight, light edges are processed first, then heavy
+     * edges already inside one component are filtered out in parallel
+     * before recursing on the rest. Joins go to the given DSU, so root
+     * data aggregates of the forest components are computed in the same
+     * pass.
+     * @tparam KeyT
+     * @tparam RootDataT
+     * @tparam Comp
+     * @tparam StatsT
+     */
+    template<class KeyT, class RootDataT, class Comp, class StatsT>
+    class FilterKruskal<DSUWithData<KeyT, RootDataT, Comp, StatsT>> {
+    private:
+        using DSU = DSUWithData<KeyT, RootDataT, Comp, StatsT>;
+
+        /**
+         * struct _IdxEdge<WeightT>
+         * Edge with endpoints resolved to DSU indices.
+         */
+        template<class WeightT>
+        struct _IdxEdge {
+            std::size_t idx1;
+            std::size_t idx2;
+            WeightT weight;
+            std::size_t edgeIdx;
+        };
+
+    public:
+
+        /**
+         * Build minimum spanning forest.
+         * @tparam WeightT - edge weight type, ordered with operator<.
+         * @param dsu - DSU to join forest edges endpoints in.
+         * @param edges - weighted edges.
+         * @param numberOfThreads - number of threads for filtering.
+         * @return indices of forest edges in order of addition.
+         */
+        template<class WeightT>
+        static std::vector<std::size_t>
+        run(DSU& dsu,
+            const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+            std::size_t numberOfThreads);
+
+    private:
+
+        /**
+         * Filter-Kruskal step on edges range.
+         * @param dsu - DSU.
+         * @param begin - edges range beginning.
+         * @param end - edges range ending.
+         * @param numberOfThreads - number of threads for filtering.
+         * @param forest - forest edges indices.
+         */
+        template<class EdgeIt>
+        static void _run(DSU& dsu,
+                         EdgeIt begin,
+                         EdgeIt end,
+                         std::size_t numberOfThreads,
+                         std::vector<std::size_t>& forest);
+
+        /**
+         * Plain Kruskal on edges range.
+         * @param dsu - DSU.
+         * @param begin - edges range beginning.
+         * @param end - edges range ending.
+         * @param forest - forest edges indices.
+         */
+        template<class EdgeIt>
+        static void _kruskal(DSU& dsu,
+                             EdgeIt begin,
+                             EdgeIt end,
+                             std::vector<std::size_t>& forest);
+
+        /**
+         * Remove edges inside one component.
+         * @param dsu - DSU.
+         * @param begin - edges range beginning.
+         * @param end - edges range ending.
+         * @param numberOfThreads - number of threads.
+         * @return end of the kept edges.
+         */
+        template<class EdgeIt>
+        static EdgeIt _filter(const DSU& dsu,
+                              EdgeIt begin,
+                              EdgeIt end,
+                              std::size_t numberOfThreads);
+
+    private:
+        // Ranges not larger than this are processed by plain Kruskal.
+        constexpr static std::size_t _kruskalThreshold = 1024;
+        // Ranges not larger than this are filtered in the calling thread.
+        constexpr static std::size_t _parallelThreshold = 1 << 15;
+    };
+
+    /**
+     * @brief class FilterKruskal<DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>>
+     * Minimum spanning forest by filter-Kruskal for deferred DSU. Scheduled
+     * joins are applied first, then forest edges are joined immediately.
+     * @tparam KeyT
+     * @tparam RootDataT
+     * @tparam Comp
+     * @tparam StatsT
+     */
+    template<class KeyT, class RootDataT, class Comp, class StatsT>
+    class FilterKruskal<DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>> {
+    private:
+        using DSU = DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>;
+        using BaseDSU = DSUWithData<KeyT, RootDataT, Comp, StatsT>;
+
+    public:
+
+        /**
+         * Build minimum spanning forest.
+         * @tparam WeightT - edge weight type, ordered with operator<.
+         * @param dsu - DSU to join forest edges endpoints in.
+         * @param edges - weighted edges.
+         * @param numberOfThreads - number of threads for filtering.
+         * @return indices of forest edges in order of addition.
+         */
+        template<class WeightT>
+        static std::vector<std::size_t>
+        run(DSU& dsu,
+            const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+            std::size_t numberOfThreads);
+    };
+
+    /**
+     * Build minimum spanning forest by filter-Kruskal.
+     * @param dsu - DSU to join forest edges endpoints in.
+     * @param edges - weighted edges.
+     * @param numberOfThreads - number of threads for filtering.
+     * @return indices of forest edges in order of addition.
+     */
+    template<class KeyT, class RootDataT, class Comp, class StatsT, class WeightT>
+    std::vector<std::size_t> filterKruskal(
+            DSUWithData<KeyT, RootDataT, Comp, StatsT>& dsu,
+            const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+            std::size_t numberOfThreads = std::thread::hardware_concurrency());
+
+    /**
+     * Build minimum spanning forest by filter-Kruskal. Scheduled joins are
+     * applied first.
+     * @param dsu - DSU to join forest edges endpoints in.
+     * @param edges - weighted edges.
+     * @param numberOfThreads - number of threads for filtering.
+     * @return indices of forest edges in order of addition.
+     */
+    template<class KeyT, class RootDataT, class Comp, class StatsT, class WeightT>
+    std::vector<std::size_t> filterKruskal(
+            DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>& dsu,
+            const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+            std::size_t numberOfThreads = std::thread::hardware_concurrency());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class WeightT>
+std::vector<std::size_t>
+gdsu::FilterKruskal<gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT>>::run(
+        DSU& dsu,
+        const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+        std::size_t numberOfThreads) {
+    numberOfThreads = std::max<std::size_t>(numberOfThreads, 1);
+
+    auto idxEdges = std::vector<_IdxEdge<WeightT>>(edges.size());
+    parallelFor(edges.size(), numberOfThreads,
+                 [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            idxEdges[i] = _IdxEdge<WeightT>{dsu._getIdxByKey(edges[i].from),
+                                            dsu._getIdxByKey(edges[i].to),
+                                            edges[i].weight,
+                                            i};
+        }
+    });
+
+    auto forest = std::vector<std::size_t>();
+    _run(dsu, idxEdges.begin(), idxEdges.end(), numberOfThreads, forest);
+    return forest;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class EdgeIt>
+void
+gdsu::FilterKruskal<gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT>>::_run(
+        DSU& dsu,
+        EdgeIt begin,
+        EdgeIt end,
+        std::size_t numberOfThreads,
+        std::vector<std::size_t>& forest) {
+    if (static_cast<std::size_t>(end - begin) <= _kruskalThreshold) {
+        _kruskal(dsu, begin, end, forest);
+        return;
+    }
+
+    // Median of three as pivot.
+    auto pivots = std::array{begin->weight,
+                             (begin + (end - begin) / 2)->weight,
+                             (end - 1)->weight};
+    std::sort(pivots.begin(), pivots.end());
+    const auto pivot = pivots[1];
+
+    auto heavyBegin = std::partition(begin, end, [&pivot](const auto& edge) {
+        return edge.weight < pivot;
+    });
+    if (heavyBegin == begin) {
+        // Pivot is the lightest weight.
+        heavyBegin = std::partition(begin, end, [&pivot](const auto& edge) {
+            return !(pivot < edge.weight);
+        });
+        if (heavyBegin == end) {
+            // All weights are equal.
+            _kruskal(dsu, begin, end, forest);
+            return;
+        }
+    }
+
+    _run(dsu, begin, heavyBegin, numberOfThreads, forest);
+    const auto heavyEnd = _filter(dsu, heavyBegin, end, numberOfThreads);
+    _run(dsu, heavyBegin, heavyEnd, numberOfThreads, forest);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class EdgeIt>
+void
+gdsu::FilterKruskal<gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT>>::_kruskal(
+        DSU& dsu,
+        EdgeIt begin,
+        EdgeIt end,
+        std::vector<std::size_t>& forest) {
+    std::sort(begin, end, [](const auto& edge1, const auto& edge2) {
+        return edge1.weight < edge2.weight;
+    });
+    for (auto edgeIt = begin; edgeIt != end; ++edgeIt) {
+        const std::size_t rootIdx1 = dsu._getRootIdxByIndex(edgeIt->idx1);
+        const std::size_t rootIdx2 = dsu._getRootIdxByIndex(edgeIt->idx2);
+        if (rootIdx1 != rootIdx2) {
+            dsu._join(rootIdx1, rootIdx2);
+            forest.push_back(edgeIt->edgeIdx);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class EdgeIt>
+EdgeIt
+gdsu::FilterKruskal<gdsu::DSUWithData<KeyT, RootDataT, Comp, StatsT>>::_filter(
+        const DSU& dsu,
+        EdgeIt begin,
+        EdgeIt end,
+        std::size_t numberOfThreads) {
+    const auto size = static_cast<std::size_t>(end - begin);
+    if (size <= _parallelThreshold) {
+        numberOfThreads = 1;
+    }
+
+    auto keep = std::vector<std::uint8_t>(size);
+    parallelFor(size, numberOfThreads,
+                 [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+            const auto& edge = *(begin + i);
+            keep[i] = dsu._findRootIdxConcurrent(edge.idx1)
+                   != dsu._findRootIdxConcurrent(edge.idx2);
+        }
+    });
+
+    auto keptEnd = begin;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (keep[i]) {
+            *keptEnd++ = std::move(*(begin + i));
+        }
+    }
+    return keptEnd;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class WeightT>
+std::vector<std::size_t> gdsu::filterKruskal(
+        DSUWithData<KeyT, RootDataT, Comp, StatsT>& dsu,
+        const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+        std::size_t numberOfThreads) {
+    return FilterKruskal<DSUWithData<KeyT, RootDataT, Comp, StatsT>>::run(
+            dsu, edges, numberOfThreads);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT>
+template<class WeightT>
+std::vector<std::size_t>
+gdsu::FilterKruskal<gdsu::DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>>::run(
+        DSU& dsu,
+        const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+        std::size_t numberOfThreads) {
+    dsu.flush();
+    return FilterKruskal<BaseDSU>::run(static_cast<BaseDSU&>(dsu),
+                                       edges, numberOfThreads);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class RootDataT, class Comp, class StatsT, class WeightT>
+std::vector<std::size_t> gdsu::filterKruskal(
+        DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>& dsu,
+        const std::vector<WeightedEdge<KeyT, WeightT>>& edges,
+        std::size_t numberOfThreads) {
+    return FilterKruskal<DeferredDSUWithData<KeyT, RootDataT, Comp, StatsT>>::run(
+            dsu, edges, numberOfThreads);
+}
+
+#endif //DSU_WITH_DATA_FILTER_KRUSKAL_HPP
@@ -0,0 +1,61 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_OFFSET_GROUP_HPP
+#define DSU_WITH_DATA_OFFSET_GROUP_HPP
+
+namespace gdsu {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct NoOffsetGroup
+    // Offset group policy for plain DSU. Parent links carry nothing.
+    // Used by default.
+    struct NoOffsetGroup {
+        struct ValueType {
+            constexpr bool operator==(const ValueType&) const = default;
+        };
+
+        constexpr static ValueType identity() { return {}; }
+        constexpr static ValueType combine(ValueType, ValueType) { return {}; }
+        constexpr static ValueType invert(ValueType) { return {}; }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct AdditiveOffsetGroup<ValueT>
+    // Offsets group of ValueT under addition. Joins encode "x - y = d"
+    // constraints.
+    template<class ValueT>
+    struct AdditiveOffsetGroup {
+        using ValueType = ValueT;
+
+        constexpr static ValueType identity() { return ValueType{}; }
+
+        constexpr static ValueType combine(const ValueType& offset1,
+                                           const ValueType& offset2) {
+            return offset1 + offset2;
+        }
+
+        constexpr static ValueType invert(const ValueType& offset) {
+            return -offset;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct ParityOffsetGroup
+    // Parity group, joins encode "x and y are of the same/different color"
+    // constraints. Contradiction means that a graph is not bipartite.
+    struct ParityOffsetGroup {
+        using ValueType = bool;
+
+        constexpr static ValueType identity() { return false; }
+
+        constexpr static ValueType combine(ValueType offset1, ValueType offset2) {
+            return offset1 != offset2;
+        }
+
+        constexpr static ValueType invert(ValueType offset) { return offset; }
+    };
+}
+
+#endif //DSU_WITH_DATA_OFFSET_GROUP_HPP
@@ -0,0 +1,64 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_PARALLEL_FOR_HPP
+#define DSU_WITH_DATA_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace gdsu {
+    /**
+     * Run task for [0, size) split in contiguous chunks, one chunk per
+     * thread. Exception of a chunk is rethrown in the calling thread.
+     * @param size - number of items.
+     * @param numberOfThreads - number of threads.
+     * @param task - callable with (chunkBegin, chunkEnd).
+     */
+    template<class TaskT>
+    void parallelFor(std::size_t size, std::size_t numberOfThreads, TaskT task);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class TaskT>
+void gdsu::parallelFor(std::size_t size,
+                       std::size_t numberOfThreads,
+                       TaskT task) {
+    numberOfThreads = std::clamp<std::size_t>(numberOfThreads, 1,
+                                              std::max<std::size_t>(size, 1));
+    if (numberOfThreads == 1) {
+        task(0, size);
+        return;
+    }
+
+    auto errors = std::vector<std::exception_ptr>(numberOfThreads);
+    auto threads = std::vector<std::thread>();
+    threads.reserve(numberOfThreads - 1);
+    const auto runChunk = [&](std::size_t chunk) {
+        try {
+            task(size * chunk / numberOfThreads,
+                 size * (chunk + 1) / numberOfThreads);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    for (std::size_t chunk = 1; chunk < numberOfThreads; ++chunk) {
+        threads.emplace_back(runChunk, chunk);
+    }
+    runChunk(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif //DSU_WITH_DATA_PARALLEL_FOR_HPP
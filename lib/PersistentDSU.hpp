@@ -0,0 +1,345 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_PERSISTENT_DSU_HPP
+#define DSU_WITH_DATA_PERSISTENT_DSU_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <numeric>
+
+#include "EytzingerKeyIndex.hpp"
+
+namespace gdsu {
+    /**
+     * @brief class PersistentDSU<KeyT, Comp>
+     * Partially persistent DSU. Every join gets the next time stamp, and
+     * connectivity can be asked for any past time. Union by size without
+     * path compression keeps trees of O(log n) height, so historical
+     * queries work in O(log n) with O(n) memory in total.
+     * It is a separate key-only class, not a mode of DSUWithData: root
+     * data would need a history of every joinWith result, which does not
+     * fit in O(n) memory.
+     * @tparam KeyT - key type.
+     * @tparam Comp - keys comparator.
+     */
+    template<class KeyT, class Comp = std::less<KeyT>>
+    class PersistentDSU {
+    public:
+
+        /**
+         * Persistent DSU constructor from keys. Repeating keys are ignored.
+         * @param keys - keys list.
+         */
+        PersistentDSU(std::initializer_list<KeyT> keys);
+
+        /**
+         * Persistent DSU constructor from container with keys objects by
+         * pair of iterators. Repeating keys are ignored.
+         * @tparam IteratorT - iterator type.
+         * @param begin - range beginning.
+         * @param end - range ending (position after last element).
+         */
+        template<class IteratorT>
+        requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
+        PersistentDSU(IteratorT begin, IteratorT end);
+
+        /**
+         * Join two components by keys. Every call, including joins of keys
+         * which are already in one component, advances time by one.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         */
+        void join(const KeyT& key1, const KeyT& key2);
+
+        /**
+         * Check if two keys are of the same component now.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @return `true if key1 and key2 are of the same component.
+         */
+        bool inSameComponent(const KeyT& key1, const KeyT& key2) const;
+
+        /**
+         * Check if two keys were of the same component after join number t.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @param time - number of joins made (0 for initial state).
+         * @return `true if key1 and key2 were of the same component.
+         */
+        bool inSameComponentAt(const KeyT& key1,
+                               const KeyT& key2,
+                               std::size_t time) const;
+
+        /**
+         * Get component size.
+         * @param key - key.
+         * @return number of elements in the same component as key.
+         */
+        std::size_t getComponentSize(const KeyT& key) const;
+
+        /**
+         * Get component size after join number t.
+         * @param key - key.
+         * @param time - number of joins made (0 for initial state).
+         * @return number of elements which were in the same component as
+         * key.
+         */
+        std::size_t getComponentSizeAt(const KeyT& key, std::size_t time) const;
+
+        /**
+         * Get number of components in the DSU.
+         * @return number of components.
+         */
+        [[nodiscard]] std::size_t getNumberOfComponents() const;
+
+        /**
+         * Get current time.
+         * @return number of joins made.
+         */
+        [[nodiscard]] std::size_t getTime() const;
+
+    private:
+
+        /**
+         * Build key index and fill parents relations data.
+         * @param keyPtrs - pointers to keys.
+         */
+        void _construct(std::vector<const KeyT*> keyPtrs);
+
+        /**
+         * Get implementation index by key.
+         * @param key - key to get index.
+         * @return index
+         */
+        std::size_t _getIdxByKey(const KeyT& key) const;
+
+        /**
+         * Root index by element index at the given time.
+         * @param idx - index if element.
+         * @param time - number of joins made.
+         * @return index of the root element of the component.
+         */
+        std::size_t _getRootIdxAt(std::size_t idx, std::size_t time) const;
+
+        /**
+         * Add size history entry for a root.
+         * @param rootIdx - root index.
+         * @param time - time of size change.
+         * @param size - new component size.
+         */
+        void _pushSize(std::size_t rootIdx, std::size_t time, std::size_t size);
+
+    private:
+
+        /**
+         * struct _SizeEntry
+         * Component size since the given time. Entries of one root are
+         * chained back in time, jump links skip over O(log n) entries, so
+         * the size at any time is found in O(log n).
+         */
+        struct _SizeEntry {
+            std::size_t time;
+            std::size_t size;
+            std::size_t prev;
+            std::size_t jump;
+            std::size_t depth;
+        };
+
+    private:
+        // Link time for roots.
+        constexpr static std::size_t _never =
+                std::numeric_limits<std::size_t>::max();
+
+        // Parents relations info
+        std::vector<std::size_t> _parents;
+        // Time of linking to parent, _never for roots
+        std::vector<std::size_t> _linkTimes;
+        // Sizes history of all roots
+        std::vector<_SizeEntry> _sizeHistory;
+        // Latest size history entry for every element
+        std::vector<std::size_t> _sizeHeads;
+        // Key to index mapping
+        EytzingerKeyIndex<KeyT, Comp> _keyIndex;
+        // Number of joins made
+        std::size_t _time{0};
+        // Number of components
+        std::size_t _numberOfComponents{0};
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+gdsu::PersistentDSU<KeyT, Comp>::PersistentDSU(
+        std::initializer_list<KeyT> keys) {
+    auto keyPtrs = std::vector<const KeyT*>();
+    keyPtrs.reserve(keys.size());
+    for (const auto& key : keys) {
+        keyPtrs.push_back(&key);
+    }
+    _construct(std::move(keyPtrs));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+template<class IteratorT>
+requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
+gdsu::PersistentDSU<KeyT, Comp>::PersistentDSU(IteratorT begin, IteratorT end) {
+    auto keyPtrs = std::vector<const KeyT*>();
+    for (auto keyIt = begin; keyIt != end; ++keyIt) {
+        keyPtrs.push_back(&*keyIt);
+    }
+    _construct(std::move(keyPtrs));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::PersistentDSU<KeyT, Comp>::join(const KeyT& key1, const KeyT& key2) {
+    std::size_t rootIdx1 = _getRootIdxAt(_getIdxByKey(key1), _time);
+    std::size_t rootIdx2 = _getRootIdxAt(_getIdxByKey(key2), _time);
+
+    ++_time;
+
+    if (rootIdx1 == rootIdx2) {
+        return;
+    }
+
+    const std::size_t size1 = _sizeHistory[_sizeHeads[rootIdx1]].size;
+    const std::size_t size2 = _sizeHistory[_sizeHeads[rootIdx2]].size;
+    if (size1 < size2) {
+        std::swap(rootIdx1, rootIdx2);
+    }
+
+    _parents[rootIdx2] = rootIdx1;
+    _linkTimes[rootIdx2] = _time;
+    _pushSize(rootIdx1, _time, size1 + size2);
+    --_numberOfComponents;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+bool gdsu::PersistentDSU<KeyT, Comp>::inSameComponent(
+        const KeyT& key1, const KeyT& key2) const {
+    return inSameComponentAt(key1, key2, _time);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+bool gdsu::PersistentDSU<KeyT, Comp>::inSameComponentAt(
+        const KeyT& key1, const KeyT& key2, std::size_t time) const {
+    return _getRootIdxAt(_getIdxByKey(key1), time)
+        == _getRootIdxAt(_getIdxByKey(key2), time);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t
+gdsu::PersistentDSU<KeyT, Comp>::getComponentSize(const KeyT& key) const {
+    return getComponentSizeAt(key, _time);
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::PersistentDSU<KeyT, Comp>::getComponentSizeAt(
+        const KeyT& key, std::size_t time) const {
+    // Latest entry not later than time. Initial entry has time 0.
+    std::size_t entryIdx = _sizeHeads[_getRootIdxAt(_getIdxByKey(key), time)];
+    while (_sizeHistory[entryIdx].time > time) {
+        const auto& entry = _sizeHistory[entryIdx];
+        entryIdx = _sizeHistory[entry.jump].time > time ? entry.jump : entry.prev;
+    }
+    return _sizeHistory[entryIdx].size;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::PersistentDSU<KeyT, Comp>::getNumberOfComponents() const {
+    return _numberOfComponents;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::PersistentDSU<KeyT, Comp>::getTime() const {
+    return _time;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::PersistentDSU<KeyT, Comp>::_construct(
+        std::vector<const KeyT*> keyPtrs) {
+    const auto keyPtrComp = [](const KeyT* key1, const KeyT* key2) {
+        return Comp()(*key1, *key2);
+    };
+    const auto keyPtrEq = [&keyPtrComp](const KeyT* key1, const KeyT* key2) {
+        return !(keyPtrComp(key1, key2) || keyPtrComp(key2, key1));
+    };
+    std::sort(keyPtrs.begin(), keyPtrs.end(), keyPtrComp);
+    keyPtrs.erase(std::unique(keyPtrs.begin(), keyPtrs.end(), keyPtrEq),
+                  keyPtrs.end());
+
+    auto keysWithIndices = std::vector<std::pair<const KeyT*, std::size_t>>();
+    keysWithIndices.reserve(keyPtrs.size());
+    for (std::size_t i = 0; i < keyPtrs.size(); ++i) {
+        keysWithIndices.emplace_back(keyPtrs[i], i);
+    }
+    _keyIndex = EytzingerKeyIndex<KeyT, Comp>(keysWithIndices);
+
+    _parents.resize(keyPtrs.size());
+    std::iota(_parents.begin(), _parents.end(), 0);
+    _linkTimes.assign(keyPtrs.size(), _never);
+    _sizeHistory.clear();
+    // Every link adds one entry.
+    _sizeHistory.reserve(2 * keyPtrs.size());
+    for (std::size_t i = 0; i < keyPtrs.size(); ++i) {
+        _sizeHistory.push_back(_SizeEntry{0, 1, i, i, 0});
+    }
+    _sizeHeads.resize(keyPtrs.size());
+    std::iota(_sizeHeads.begin(), _sizeHeads.end(), 0);
+    _numberOfComponents = keyPtrs.size();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::PersistentDSU<KeyT, Comp>::_getIdxByKey(
+        const KeyT& key) const {
+    if (const std::size_t idx = _keyIndex.find(key);
+            idx == EytzingerKeyIndex<KeyT, Comp>::npos) {
+        throw std::invalid_argument("No such key.");
+    } else {
+        return idx;
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+std::size_t gdsu::PersistentDSU<KeyT, Comp>::_getRootIdxAt(
+        std::size_t idx, std::size_t time) const {
+    time = std::min(time, _time);
+    while (_linkTimes[idx] <= time) {
+        idx = _parents[idx];
+    }
+    return idx;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, class Comp>
+void gdsu::PersistentDSU<KeyT, Comp>::_pushSize(
+        std::size_t rootIdx, std::size_t time, std::size_t size) {
+    const std::size_t prevIdx = _sizeHeads[rootIdx];
+    const auto& prev = _sizeHistory[prevIdx];
+    const auto& prevJump = _sizeHistory[prev.jump];
+    // Skew-binary jump links.
+    const std::size_t jumpIdx =
+            prev.depth - prevJump.depth == prevJump.depth - _sizeHistory[prevJump.jump].depth
+            ? prevJump.jump
+            : prevIdx;
+    _sizeHeads[rootIdx] = _sizeHistory.size();
+    _sizeHistory.push_back(_SizeEntry{time, size, prevIdx, jumpIdx, prev.depth + 1});
+}
+
+#endif //DSU_WITH_DATA_PERSISTENT_DSU_HPP
@@ -0,0 +1,59 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_ROOT_DATA_LAYOUT_HPP
+#define DSU_WITH_DATA_ROOT_DATA_LAYOUT_HPP
+
+namespace gdsu {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // class NoHotData
+    // Empty hot part for root data types which do not declare one.
+    class NoHotData {
+    public:
+        template<class RootDataT>
+        constexpr explicit NoHotData(const RootDataT&) {}
+
+        constexpr void joinWith(const NoHotData&) {}
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct DefaultHotData<RootDataT>
+    // RootDataT::HotData if declared, NoHotData otherwise.
+    template<class RootDataT>
+    struct DefaultHotData {
+        using Type = NoHotData;
+    };
+
+    template<class RootDataT>
+    requires requires { typename RootDataT::HotData; }
+    struct DefaultHotData<RootDataT> {
+        using Type = typename RootDataT::HotData;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // struct RootDataLayout<RootDataT>
+    // Layout policy of root data. HotData is stored next to parent link and
+    // component size in one array, so finds and hot data reads touch one
+    // cache line per hop. The rest of RootDataT is stored out of line.
+    // Fields of HotData should not be kept in RootDataT too: they are not
+    // synchronized. Component size is always kept by DSU.
+    // HotData must be constructible from RootDataT and have
+    // joinWith(const HotData&). It may have detach(const KeyT&) to handle
+    // erased elements. By default RootDataT::HotData is used if declared.
+    // If lazyJoin is true, joinWith of RootDataT is not called on union.
+    // Joined components are recorded and merged in one batch when root data
+    // of the component is requested. By default it is set by
+    // RootDataT::lazyJoin static member if declared. Merge order is the same
+    // as for eager joins.
+    // Specialize to set a layout for a foreign root data type.
+    template<class RootDataT>
+    struct RootDataLayout {
+        using HotData = typename DefaultHotData<RootDataT>::Type;
+        constexpr static bool lazyJoin =
+                requires { requires RootDataT::lazyJoin; };
+    };
+}
+
+#endif //DSU_WITH_DATA_ROOT_DATA_LAYOUT_HPP
@@ -0,0 +1,296 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_WITH_DATA_STATIC_DSU_WITH_DATA_HPP
+#define DSU_WITH_DATA_STATIC_DSU_WITH_DATA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "DefaultDSUData.hpp"
+
+namespace gdsu {
+    /**
+     * @brief class StaticDSUWithData<KeyT, N, RootDataT, Comp>
+     * Fixed capacity DSU with no heap allocations. All storage is placed
+     * in std::array members, so the object may be created and used in
+     * constexpr context and cheaply reset for reuse. Intended for small
+     * problems solved many times.
+     * @tparam KeyT - key type.
+     * @tparam N - maximum number of keys.
+     * @tparam RootDataT - root data type.
+     * @tparam Comp - keys comparator.
+     */
+    template<class KeyT,
+             std::size_t N,
+             class RootDataT = BaseRootDSUData<KeyT>,
+             class Comp = std::less<KeyT>>
+    class StaticDSUWithData {
+    private:
+        // Smallest index type which fits N.
+        using IdxT =
+                std::conditional_t<(N <= UINT8_MAX), std::uint8_t,
+                std::conditional_t<(N <= UINT16_MAX), std::uint16_t,
+                                   std::uint32_t>>;
+
+    public:
+
+        /**
+         * Static DSU constructor from keys. Repeating keys are ignored.
+         * @param keys - keys list. Throws std::length_error if there are
+         * more than N unique keys.
+         */
+        constexpr StaticDSUWithData(std::initializer_list<KeyT> keys);
+
+        /**
+         * Static DSU constructor from container with keys objects by pair
+         * of iterators. Repeating keys are ignored.
+         * @tparam IteratorT - iterator type.
+         * @param begin - range beginning.
+         * @param end - range ending (position after last element).
+         * Throws std::length_error if there are more than N unique keys.
+         */
+        template<class IteratorT>
+        requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
+        constexpr StaticDSUWithData(IteratorT begin, IteratorT end);
+
+        /**
+         * Join two components by keys.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         */
+        constexpr void join(const KeyT& key1, const KeyT& key2);
+
+        /**
+         * Check if two keys are of the same component.
+         * @param key1 - first key.
+         * @param key2 - second key.
+         * @return `true if key1 and key2 are of the same component.
+         */
+        constexpr bool inSameComponent(const KeyT& key1, const KeyT& key2) const;
+
+        /**
+         * Get component size.
+         * @param key - key.
+         * @return number of elements in the same component as key.
+         */
+        constexpr std::size_t getComponentSize(const KeyT& key) const;
+
+        /**
+         * Get number of components in the DSU.
+         * @return number of components.
+         */
+        [[nodiscard]] constexpr std::size_t getNumberOfComponents() const;
+
+        /**
+         * Root data by key.
+         * @param key - key to search.
+         * @return rootDataOfTheComponent.
+         */
+        constexpr const RootDataT& getRootData(const KeyT& key) const;
+
+        /**
+         * Split all components back to single elements. Keys are kept.
+         */
+        constexpr void reset();
+
+    private:
+
+        /**
+         * Sort keys and remove repeats.
+         */
+        constexpr void _sortUniqueKeys();
+
+        /**
+         * Get implementation index by key.
+         * @param key - key to get index.
+         * @return index
+         */
+        constexpr std::size_t _getIdxByKey(const KeyT& key) const;
+
+        /**
+         * Root index by element index. Trees are kept shallow by joins,
+         * so queries do not modify the object.
+         * @param idx - index if element.
+         * @return index of the root element of the component.
+         */
+        constexpr std::size_t _getRootIdxByIndex(std::size_t idx) const;
+
+        /**
+         * Root index by element index with path halving.
+         * @param idx - index if element.
+         * @return index of the root element of the component.
+         */
+        constexpr std::size_t _compressToRoot(std::size_t idx);
+
+    private:
+        // Sorted keys, first _numberOfKeys are used
+        std::array<KeyT, N> _keys{};
+        // Parents relations info
+        std::array<IdxT, N> _parents{};
+        // Components sizes, set for roots only
+        std::array<IdxT, N> _sizes{};
+        // Root data, set for roots only
+        std::array<std::optional<RootDataT>, N> _data{};
+        // Number of keys
+        std::size_t _numberOfKeys{0};
+        // Number of components
+        std::size_t _numberOfComponents{0};
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::StaticDSUWithData(
+        std::initializer_list<KeyT> keys)
+        : StaticDSUWithData(keys.begin(), keys.end()) {}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+template<class IteratorT>
+requires std::is_same_v<std::iter_value_t<IteratorT>, KeyT>
+constexpr gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::StaticDSUWithData(
+        IteratorT begin, IteratorT end) {
+    // Keys are deduplicated only when storage is full, so repeats do not
+    // count against capacity.
+    std::size_t sortedSize = 0;
+    for (auto keyIt = begin; keyIt != end; ++keyIt) {
+        if (_numberOfKeys == N && sortedSize != N) {
+            _sortUniqueKeys();
+            sortedSize = _numberOfKeys;
+        }
+        if (_numberOfKeys == N) {
+            if (!std::binary_search(_keys.begin(), _keys.end(), *keyIt, Comp())) {
+                throw std::length_error("Too many keys for static DSU.");
+            }
+            continue;
+        }
+        _keys[_numberOfKeys++] = *keyIt;
+    }
+    _sortUniqueKeys();
+    reset();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr void gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::join(
+        const KeyT& key1, const KeyT& key2) {
+    std::size_t rootIdx1 = _compressToRoot(_getIdxByKey(key1));
+    std::size_t rootIdx2 = _compressToRoot(_getIdxByKey(key2));
+
+    if (rootIdx1 == rootIdx2) {
+        return;
+    }
+
+    if (_sizes[rootIdx1] < _sizes[rootIdx2]) {
+        std::swap(rootIdx1, rootIdx2);
+    }
+
+    _parents[rootIdx2] = static_cast<IdxT>(rootIdx1);
+    _sizes[rootIdx1] += _sizes[rootIdx2];
+    _data[rootIdx1]->joinWith(*_data[rootIdx2]);
+    _data[rootIdx2].reset();
+    --_numberOfComponents;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr bool
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::inSameComponent(
+        const KeyT& key1, const KeyT& key2) const {
+    return _getRootIdxByIndex(_getIdxByKey(key1))
+        == _getRootIdxByIndex(_getIdxByKey(key2));
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr std::size_t
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::getComponentSize(
+        const KeyT& key) const {
+    return _sizes[_getRootIdxByIndex(_getIdxByKey(key))];
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr std::size_t
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::getNumberOfComponents() const {
+    return _numberOfComponents;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr const RootDataT&
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::getRootData(
+        const KeyT& key) const {
+    return *_data[_getRootIdxByIndex(_getIdxByKey(key))];
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr void gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::reset() {
+    for (std::size_t i = 0; i < _numberOfKeys; ++i) {
+        _parents[i] = static_cast<IdxT>(i);
+        _sizes[i] = 1;
+        _data[i].emplace(_keys[i]);
+    }
+    _numberOfComponents = _numberOfKeys;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr void
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::_sortUniqueKeys() {
+    const auto keysEnd = _keys.begin() + _numberOfKeys;
+    std::sort(_keys.begin(), keysEnd, Comp());
+    _numberOfKeys = std::unique(_keys.begin(), keysEnd,
+                                [](const KeyT& key1, const KeyT& key2) {
+                                    return !(Comp()(key1, key2)
+                                             || Comp()(key2, key1));
+                                }) - _keys.begin();
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr std::size_t
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::_getIdxByKey(
+        const KeyT& key) const {
+    const auto keysEnd = _keys.begin() + _numberOfKeys;
+    if (auto it = std::lower_bound(_keys.begin(), keysEnd, key, Comp());
+            it == keysEnd || Comp()(key, *it)) {
+        throw std::invalid_argument("No such key.");
+    } else {
+        return it - _keys.begin();
+    }
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr std::size_t
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::_getRootIdxByIndex(
+        std::size_t idx) const {
+    while (_parents[idx] != idx) {
+        idx = _parents[idx];
+    }
+    return idx;
+}
+
+//----------------------------------------------------------------------------//
+template<class KeyT, std::size_t N, class RootDataT, class Comp>
+constexpr std::size_t
+gdsu::StaticDSUWithData<KeyT, N, RootDataT, Comp>::_compressToRoot(
+        std::size_t idx) {
+    while (_parents[idx] != idx) {
+        _parents[idx] = _parents[_parents[idx]];
+        idx = _parents[idx];
+    }
+    return idx;
+}
+
+#endif //DSU_WITH_DATA_STATIC_DSU_WITH_DATA_HPP
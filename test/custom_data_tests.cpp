@@ -6,6 +6,8 @@
 #include <DSUWithData.hpp>
 #include "samples/test_dsu_data.hpp"
 #include "samples/greatest_element_dsu_data.hpp"
+#include "samples/hot_cold_dsu_data.hpp"
+#include "samples/lazy_dsu_data.hpp"
 
 
 //----------------------------------------------------------------------------//
@@ -18,6 +20,19 @@ TEST(CustomData, FloatAvgData) {
     EXPECT_FLOAT_EQ(dsu.getRootData(2).getAvg(), 2.5);
 }
 
+//----------------------------------------------------------------------------//
+TEST(CustomData, OwnSizeIsNotComponentSize) {
+    auto dsu = gdsu::DSUWithData<int, WeightRootData>{1, 2, 100};
+
+    dsu.join(1, 2);
+    // Heavier root data does not make its component bigger.
+    dsu.join(100, 2);
+
+    EXPECT_EQ(dsu.getComponentSize(100), 3);
+    EXPECT_EQ(dsu.getRootData(100).getWeight(), 103);
+    EXPECT_EQ(dsu.getRootData(100).getKey(), 1);
+}
+
 //----------------------------------------------------------------------------//
 TEST(CustomData, GreatestData) {
     auto dsu =
@@ -62,3 +77,137 @@ TEST(CustomData, SmallestString) {
     EXPECT_EQ(dsu.getRootData("crmn").getGreatest(), "caba");
     EXPECT_EQ(dsu.getComponentSize("caba"), 2);
 }
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, HotColdData) {
+    auto dsu = gdsu::DSUWithData<int, MembersRootDsuData>{4, 8, 15, 16, 23};
+
+    dsu.join(8, 16);
+    dsu.join(23, 16);
+
+    EXPECT_EQ(dsu.getRootHotData(8).min, 8);
+    EXPECT_EQ(dsu.getRootHotData(8).max, 23);
+    EXPECT_EQ(dsu.getRootHotData(4).max, 4);
+    EXPECT_EQ(dsu.getRootData(23).getMembers().size(), 3);
+    EXPECT_EQ(dsu.getComponentSize(16), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, HotColdDataCompact) {
+    auto dsu = gdsu::DSUWithData<int, MembersRootDsuData>{4, 8, 15, 16, 23};
+
+    dsu.join(8, 16);
+    dsu.join(23, 16);
+    dsu.erase(dsu.getRootData(8).getKey());
+    dsu.erase(4);
+    dsu.compact();
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(dsu.getComponentSize(23), 2);
+    EXPECT_EQ(dsu.getRootHotData(23).max, 23);
+    EXPECT_EQ(dsu.getRootHotData(15).min, 15);
+}
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, LazyJoinMergesOnRequest) {
+    auto dsu = gdsu::DSUWithData<int, LazyMembersRootDsuData>{1, 2, 3, 4, 5, 6};
+    LazyMembersRootDsuData::numberOfMerges = 0;
+
+    dsu.join(1, 2);
+    dsu.join(3, 4);
+    dsu.join(5, 6);
+    dsu.join(1, 3);
+
+    EXPECT_EQ(LazyMembersRootDsuData::numberOfMerges, 0);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(dsu.getComponentSize(4), 4);
+    EXPECT_TRUE(dsu.inSameComponent(2, 4));
+
+    EXPECT_EQ(dsu.getRootData(4).getMembers().size(), 4);
+    EXPECT_EQ(LazyMembersRootDsuData::numberOfMerges, 3);
+
+    // Not requested component is still not merged.
+    EXPECT_EQ(dsu.getComponentSize(5), 2);
+    EXPECT_EQ(LazyMembersRootDsuData::numberOfMerges, 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, LazyJoinSameAsEager) {
+    auto lazyDsu = gdsu::DSUWithData<int, LazyMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8};
+    auto eagerDsu = gdsu::DSUWithData<int, EagerMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8};
+
+    const auto joins = std::vector<std::pair<int, int>>{
+        {1, 2}, {3, 4}, {2, 4}, {5, 6}, {7, 5}, {8, 1}, {6, 8}};
+    for (std::size_t i = 0; i < joins.size(); ++i) {
+        lazyDsu.join(joins[i].first, joins[i].second);
+        eagerDsu.join(joins[i].first, joins[i].second);
+        if (i == 2) {
+            // Merge part of the lazy joins in the middle.
+            EXPECT_EQ(lazyDsu.getRootData(1).getMembers(),
+                      eagerDsu.getRootData(1).getMembers());
+        }
+    }
+
+    EXPECT_EQ(lazyDsu.getRootData(7).getMembers(),
+              eagerDsu.getRootData(7).getMembers());
+    EXPECT_EQ(lazyDsu.getComponentSize(7), 8);
+}
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, LazyJoinEraseAndCompact) {
+    auto lazyDsu = gdsu::DSUWithData<int, LazyMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto eagerDsu = gdsu::DSUWithData<int, EagerMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    const auto build = [](auto& dsu) {
+        dsu.join(5, 6);
+        dsu.erase(5);
+        dsu.join(1, 2);
+        dsu.join(3, 4);
+        dsu.join(2, 3);
+        // Erased root 5 becomes a pending merge.
+        dsu.join(6, 1);
+        dsu.join(7, 8);
+        dsu.erase(9);
+    };
+    build(lazyDsu);
+    build(eagerDsu);
+
+    const std::size_t numberOfMerges = LazyMembersRootDsuData::numberOfMerges;
+    lazyDsu.compact();
+    eagerDsu.compact();
+    EXPECT_EQ(LazyMembersRootDsuData::numberOfMerges, numberOfMerges);
+
+    EXPECT_EQ(lazyDsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(lazyDsu.getComponentSize(4), 5);
+    EXPECT_EQ(lazyDsu.getRootData(7).getMembers(),
+              eagerDsu.getRootData(7).getMembers());
+    EXPECT_EQ(lazyDsu.getComponentSize(2), 5);
+    EXPECT_EQ(lazyDsu.getRootData(2).getMembers(),
+              eagerDsu.getRootData(2).getMembers());
+}
+
+//----------------------------------------------------------------------------//
+TEST(CustomData, LazyJoinReorder) {
+    auto lazyDsu = gdsu::DSUWithData<int, LazyMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8};
+    auto eagerDsu = gdsu::DSUWithData<int, EagerMembersRootDsuData>{
+        1, 2, 3, 4, 5, 6, 7, 8};
+
+    for (const auto& [key1, key2] : std::vector<std::pair<int, int>>{
+            {8, 2}, {3, 7}, {2, 7}, {5, 1}}) {
+        lazyDsu.join(key1, key2);
+        eagerDsu.join(key1, key2);
+    }
+    lazyDsu.reorder();
+    eagerDsu.reorder();
+
+    EXPECT_EQ(lazyDsu.getRootData(3).getMembers(),
+              eagerDsu.getRootData(3).getMembers());
+    EXPECT_EQ(lazyDsu.getRootData(1).getMembers(),
+              eagerDsu.getRootData(1).getMembers());
+    EXPECT_EQ(lazyDsu.getNumberOfComponents(), 4);
+}
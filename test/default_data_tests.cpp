@@ -4,10 +4,32 @@
 
 #include <vector>
 #include <list>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
 
 #include <gtest/gtest.h>
 #include <DSUWithData.hpp>
 
+namespace {
+    ////////////////////////////////////////////////////////////////////////////
+    // struct CopyCountingKey
+    // Integer key which counts its copies.
+    struct CopyCountingKey {
+        CopyCountingKey(int value) : value(value) {}
+        CopyCountingKey(const CopyCountingKey& other) : value(other.value) { ++copies; }
+        CopyCountingKey(CopyCountingKey&& other) = default;
+        CopyCountingKey& operator=(const CopyCountingKey& other) = default;
+        CopyCountingKey& operator=(CopyCountingKey&& other) = default;
+
+        bool operator<(const CopyCountingKey& other) const { return value < other.value; }
+
+        int value;
+        inline static std::size_t copies = 0;
+    };
+}
+
 //----------------------------------------------------------------------------//
 TEST(DefaultData, KeysConstructor) {
     auto dsu = gdsu::DSUWithData<int>{0, 1, 3};
@@ -292,3 +314,265 @@ TEST(DefaultData, NoSuchKeyComponentSize) {
     dsu.join(2, 3);
     EXPECT_THROW(dsu.getComponentSize(42), std::invalid_argument);
 }
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, ComponentStatsInitial) {
+    auto dsu = gdsu::DSUWithData<int, gdsu::BaseRootDSUData<int>,
+                                 std::less<int>, gdsu::ComponentStats>{1, 2, 3};
+    const auto& stats = dsu.getComponentStats();
+
+    EXPECT_EQ(stats.getMaxComponentSize(), 1);
+    EXPECT_EQ(stats.getNumberOfSingletons(), 3);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(0), 3);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(1), 0);
+    EXPECT_EQ(stats.getSizeHistogram()[0], 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, ComponentStatsAfterJoins) {
+    auto dsu = gdsu::DSUWithData<int, gdsu::BaseRootDSUData<int>,
+                                 std::less<int>, gdsu::ComponentStats>{
+        1, 2, 3, 4, 5, 6, 7
+    };
+
+    dsu.join(1, 2);
+    dsu.join(3, 4);
+    dsu.join(1, 3);
+    dsu.join(5, 6);
+    dsu.join(2, 4);
+
+    const auto& stats = dsu.getComponentStats();
+    EXPECT_EQ(stats.getMaxComponentSize(), 4);
+    EXPECT_EQ(stats.getNumberOfSingletons(), 1);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(1), 2);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(2), 1);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(4), 0);
+    EXPECT_EQ(stats.getSizeHistogram()[0], 1);
+    EXPECT_EQ(stats.getSizeHistogram()[1], 1);
+    EXPECT_EQ(stats.getSizeHistogram()[2], 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, JoinSingleToBiggerComponent) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3};
+
+    dsu.join(1, 2);
+    dsu.join(3, 1);
+
+    EXPECT_EQ(dsu.getComponentSize(3), 3);
+    EXPECT_EQ(dsu.getComponentSize(1), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, EraseKey) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3, 4};
+    dsu.join(1, 2);
+    dsu.join(2, 3);
+
+    dsu.erase(2);
+
+    EXPECT_EQ(dsu.getNumberOfTombstones(), 1);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(dsu.getComponentSize(1), 2);
+    EXPECT_TRUE(dsu.inSameComponent(1, 3));
+    EXPECT_THROW(dsu.getComponentSize(2), std::invalid_argument);
+    EXPECT_THROW(dsu.erase(2), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, EraseLastElementOfComponent) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3};
+    dsu.join(1, 2);
+
+    dsu.erase(3);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+
+    dsu.erase(1);
+    dsu.erase(2);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, CompactAfterErase) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3, 4, 5, 6};
+    dsu.join(1, 2);
+    dsu.join(2, 3);
+    dsu.join(4, 5);
+    const auto rootKey = dsu.getRootData(3).getKey();
+
+    dsu.erase(rootKey);
+    dsu.erase(5);
+    dsu.compact();
+
+    EXPECT_EQ(dsu.getNumberOfTombstones(), 0);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    EXPECT_EQ(dsu.getComponentSize(4), 1);
+    EXPECT_EQ(dsu.getComponentSize(6), 1);
+    EXPECT_THROW(dsu.getComponentSize(5), std::invalid_argument);
+
+    auto rest = std::vector<int>();
+    for (int key : {1, 2, 3}) {
+        if (key != rootKey) {
+            rest.push_back(key);
+        }
+    }
+    EXPECT_TRUE(dsu.inSameComponent(rest[0], rest[1]));
+    EXPECT_EQ(dsu.getComponentSize(rest[0]), 2);
+
+    dsu.join(rest[0], 6);
+    dsu.join(4, 6);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+    EXPECT_EQ(dsu.getComponentSize(4), 4);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, ComponentStatsAfterErase) {
+    auto dsu = gdsu::DSUWithData<int, gdsu::BaseRootDSUData<int>,
+                                 std::less<int>, gdsu::ComponentStats>{
+        1, 2, 3, 4, 5
+    };
+    dsu.join(1, 2);
+    dsu.join(1, 3);
+    dsu.join(4, 5);
+
+    dsu.erase(1);
+    dsu.erase(2);
+
+    const auto& stats = dsu.getComponentStats();
+    EXPECT_EQ(stats.getMaxComponentSize(), 2);
+    EXPECT_EQ(stats.getNumberOfSingletons(), 1);
+    EXPECT_EQ(stats.getNumberOfComponentsLargerThan(1), 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, KeysInitializerListUniqueKeysFlag) {
+    auto dsu = gdsu::DSUWithData<int>(std::initializer_list<int>{0, 1, 3},
+                                      std::bool_constant<true>());
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    dsu.join(0, 3);
+    EXPECT_EQ(dsu.getComponentSize(3), 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, IotaRangeConstructor) {
+    auto dsu = gdsu::DSUWithData<std::size_t>(std::views::iota(0, 100),
+                                              std::bool_constant<true>());
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 100);
+    dsu.join(10, 99);
+    EXPECT_TRUE(dsu.inSameComponent(99, 10));
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, TransformRangeConstructor) {
+    const auto values = std::vector<int>{3, 1, 2, 1, 3};
+    auto dsu = gdsu::DSUWithData<std::string>(
+            values | std::views::transform([](int value) {
+                return std::string(value, 'a');
+            }));
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    dsu.join("a", "aaa");
+    EXPECT_EQ(dsu.getComponentSize("aaa"), 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, InputRangeConstructor) {
+    auto stream = std::istringstream("5 3 8 3 5");
+    auto dsu = gdsu::DSUWithData<int>(std::views::istream<int>(stream));
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    EXPECT_THROW(dsu.join(5, 4), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, RangeConstructorKeyCopies) {
+    auto keys = std::vector<CopyCountingKey>();
+    for (int i = 100; i > 0; --i) {
+        keys.emplace_back(i);
+    }
+
+    CopyCountingKey::copies = 0;
+    auto copyingDsu = gdsu::DSUWithData<CopyCountingKey>(keys);
+    // Root data and key index.
+    EXPECT_EQ(CopyCountingKey::copies, 200);
+
+    CopyCountingKey::copies = 0;
+    auto movingDsu = gdsu::DSUWithData<CopyCountingKey>(std::move(keys));
+    // Key index only.
+    EXPECT_EQ(CopyCountingKey::copies, 100);
+
+    movingDsu.join(1, 100);
+    EXPECT_EQ(movingDsu.getComponentSize(100), 2);
+    EXPECT_EQ(copyingDsu.getNumberOfComponents(), 100);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, RootDataRangeConstructor) {
+    auto rootData = std::vector<gdsu::BaseRootDSUData<int>>();
+    for (int i = 0; i < 10; ++i) {
+        rootData.emplace_back(9 - i);
+    }
+
+    auto dsu = gdsu::DSUWithData<int>(std::move(rootData));
+    EXPECT_EQ(dsu.getNumberOfComponents(), 10);
+    dsu.join(0, 9);
+    EXPECT_EQ(dsu.getComponentSize(0), 2);
+
+    auto repeating = std::vector<gdsu::BaseRootDSUData<int>>();
+    repeating.emplace_back(1);
+    repeating.emplace_back(1);
+    EXPECT_THROW(gdsu::DSUWithData<int>{repeating}, std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, ReorderKeepsComponents) {
+    constexpr int size = 2000;
+    auto dsu = gdsu::DSUWithData<int>(std::views::iota(0, size));
+    auto gen = std::mt19937(7);
+    auto keyDistr = std::uniform_int_distribution<int>(0, size - 1);
+    for (int i = 0; i < size / 2; ++i) {
+        dsu.join(keyDistr(gen), keyDistr(gen));
+    }
+    auto reordered = dsu;
+
+    reordered.reorder(3);
+
+    EXPECT_EQ(reordered.getNumberOfComponents(), dsu.getNumberOfComponents());
+    for (int i = 0; i < size; ++i) {
+        const int key1 = keyDistr(gen);
+        const int key2 = keyDistr(gen);
+        EXPECT_EQ(reordered.inSameComponent(key1, key2),
+                  dsu.inSameComponent(key1, key2));
+        EXPECT_EQ(reordered.getComponentSize(key1), dsu.getComponentSize(key1));
+        EXPECT_EQ(reordered.getRootData(key1).getKey(),
+                  dsu.getRootData(key1).getKey());
+    }
+
+    reordered.join(0, size - 1);
+    dsu.join(0, size - 1);
+    EXPECT_EQ(reordered.getComponentSize(0), dsu.getComponentSize(0));
+}
+
+//----------------------------------------------------------------------------//
+TEST(DefaultData, ReorderWithTombstones) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3, 4, 5, 6};
+
+    dsu.join(1, 4);
+    dsu.join(6, 4);
+    dsu.join(2, 5);
+    dsu.erase(dsu.getRootData(6).getKey());
+    dsu.erase(3);
+    dsu.reorder();
+
+    EXPECT_EQ(dsu.getNumberOfTombstones(), 2);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(dsu.getComponentSize(5), 2);
+    EXPECT_THROW(dsu.getComponentSize(3), std::invalid_argument);
+
+    dsu.compact();
+    dsu.join(5, 4);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+    EXPECT_EQ(dsu.getComponentSize(4), 4);
+}
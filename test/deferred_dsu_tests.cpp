@@ -0,0 +1,177 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <DeferredDSUWithData.hpp>
+#include "samples/greatest_element_dsu_data.hpp"
+#include "samples/hot_cold_dsu_data.hpp"
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, JoinsArePending) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4};
+
+    dsu.join(1, 2);
+    dsu.join(3, 4);
+
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 2);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, ExplicitFlush) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4};
+
+    dsu.join(4, 1);
+    dsu.join(1, 4);
+    dsu.flush();
+
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 0);
+    EXPECT_TRUE(dsu.inSameComponent(1, 4));
+    EXPECT_EQ(dsu.getComponentSize(4), 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, SameAnswersAsEager) {
+    constexpr int n = 200;
+    auto keys = std::vector<int>(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    auto eager = gdsu::DSUWithData<int>(keys.begin(), keys.end());
+    auto deferred = gdsu::DeferredDSUWithData<int>(keys.begin(), keys.end());
+
+    for (int i = 0; i < n / 2; ++i) {
+        eager.join((i * 13) % n, (i * 71) % n);
+        deferred.join((i * 13) % n, (i * 71) % n);
+        if (i % 17 == 0) {
+            ASSERT_EQ(deferred.getNumberOfComponents(),
+                      eager.getNumberOfComponents());
+        }
+    }
+
+    for (int key = 0; key < n; ++key) {
+        ASSERT_EQ(deferred.getComponentSize(key), eager.getComponentSize(key));
+        ASSERT_EQ(deferred.inSameComponent(0, key), eager.inSameComponent(0, key));
+        ASSERT_EQ(deferred.getRootData(key).getKey(),
+                  eager.getRootData(key).getKey());
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, JoinsAppliedInCallOrder) {
+    auto eager = gdsu::DSUWithData<int>{1, 2, 3, 4};
+    auto deferred = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4};
+
+    for (const auto& [key1, key2] : {std::pair{3, 4}, {1, 2}, {4, 1}}) {
+        eager.join(key1, key2);
+        deferred.join(key1, key2);
+    }
+
+    EXPECT_EQ(eager.getRootData(1).getKey(), 3);
+    EXPECT_EQ(deferred.getRootData(1).getKey(), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, NoEagerView) {
+    // Eager queries through a base reference would miss scheduled joins.
+    static_assert(!std::is_convertible_v<gdsu::DeferredDSUWithData<int>&,
+                                         gdsu::DSUWithData<int>&>);
+    static_assert(!std::is_convertible_v<const gdsu::DeferredDSUWithData<int>&,
+                                         const gdsu::DSUWithData<int>&>);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, RootDataAndStats) {
+    auto dsu = gdsu::DeferredDSUWithData<int, GreatestElementRootDsuData<int>,
+                                         std::less<int>, gdsu::ComponentStats>{
+        1, 3, 6, 5
+    };
+
+    dsu.join(6, 1);
+    dsu.join(1, 3);
+
+    EXPECT_EQ(dsu.getComponentStats().getMaxComponentSize(), 3);
+    EXPECT_EQ(dsu.getRootData(3).getGreatest(), 6);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, NoSuchKeyOnJoin) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3};
+
+    EXPECT_THROW(dsu.join(3, 5), std::invalid_argument);
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, EraseFlushesJoins) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3};
+
+    dsu.join(1, 2);
+    dsu.join(2, 3);
+    dsu.erase(2);
+    dsu.compact();
+
+    EXPECT_TRUE(dsu.inSameComponent(1, 3));
+    EXPECT_EQ(dsu.getComponentSize(3), 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, JoinAll) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4, 5};
+    const auto pairs = std::vector<std::pair<int, int>>{{1, 2}, {2, 3}, {5, 5}};
+
+    dsu.joinAll(pairs, 2);
+
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 3);
+    EXPECT_EQ(dsu.getComponentSize(3), 3);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, JoinAllNoSuchKey) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3};
+    const auto pairs = std::vector<std::pair<int, int>>{{1, 2}, {2, 7}};
+
+    EXPECT_THROW(dsu.joinAll(pairs, 2), std::invalid_argument);
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, JoinAllFlatKeys) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4, 5};
+    const auto keys = std::vector<int>{1, 2, 3, 4, 2, 3};
+
+    dsu.joinAll(keys, 2);
+
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 3);
+    EXPECT_EQ(dsu.getComponentSize(4), 4);
+    EXPECT_THROW(dsu.joinAll(std::vector<int>{1, 2, 3}), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, ReorderFlushes) {
+    auto dsu = gdsu::DeferredDSUWithData<int>{1, 2, 3, 4, 5};
+
+    dsu.join(5, 1);
+    dsu.join(2, 4);
+    dsu.reorder();
+
+    EXPECT_EQ(dsu.getNumberOfPendingJoins(), 0);
+    dsu.join(4, 5);
+    EXPECT_EQ(dsu.getComponentSize(1), 4);
+    EXPECT_EQ(dsu.getComponentSize(3), 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(DeferredDSU, RootHotDataFlushes) {
+    auto dsu = gdsu::DeferredDSUWithData<int, MembersRootDsuData>{8, 4, 16};
+
+    dsu.join(8, 16);
+
+    EXPECT_EQ(dsu.getRootHotData(8).max, 16);
+    EXPECT_EQ(dsu.getRootHotData(16).min, 8);
+    EXPECT_EQ(dsu.getRootHotData(4).max, 4);
+}
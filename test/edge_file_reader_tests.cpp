@@ -0,0 +1,180 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <EdgeFileReader.hpp>
+
+namespace {
+    std::string writeTempFile(const std::string& name, const std::string& contents) {
+        const auto path = std::filesystem::temp_directory_path() / name;
+        auto out = std::ofstream(path, std::ios::binary);
+        out << contents;
+        return path.string();
+    }
+
+    using Edge = gdsu::EdgeFileReader<std::uint64_t>::Edge;
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, ParseText) {
+    const auto path = writeTempFile("dsu_edges_text.txt",
+                                    "# comment\n"
+                                    "1 2\n"
+                                    "\n"
+                                    "  3\t4 0.5\r\n"
+                                    "% other comment\n"
+                                    "5 1");
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Text);
+
+    for (std::size_t numberOfThreads : {1, 3, 16}) {
+        EXPECT_EQ(reader.readEdges(numberOfThreads),
+                  (std::vector<Edge>{{1, 2}, {3, 4}, {5, 1}}));
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, ParseLongText) {
+    auto contents = std::string();
+    auto expected = std::vector<Edge>();
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        contents += std::to_string(i) + " " + std::to_string(i * 7 % 10000) + "\n";
+        expected.emplace_back(i, i * 7 % 10000);
+    }
+    const auto path = writeTempFile("dsu_edges_long.txt", contents);
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Text);
+
+    EXPECT_EQ(reader.readEdges(7), expected);
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, MalformedText) {
+    const auto path = writeTempFile("dsu_edges_bad.txt", "1 2\n3 x\n");
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Text);
+
+    EXPECT_THROW((void)reader.readEdges(2), std::runtime_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, ParseBinary) {
+    const auto keys = std::vector<std::uint64_t>{10, 20, 30, 10};
+    const auto path = writeTempFile(
+            "dsu_edges.bin",
+            std::string(reinterpret_cast<const char*>(keys.data()),
+                        keys.size() * sizeof(std::uint64_t)));
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Binary);
+
+    EXPECT_EQ(reader.viewBinaryKeys().size(), 4);
+    EXPECT_EQ(reader.readEdges(2), (std::vector<Edge>{{10, 20}, {30, 10}}));
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, NoSuchFile) {
+    EXPECT_THROW(gdsu::EdgeFileReader<std::uint64_t>(
+                         "/nonexistent/dsu_edges.txt", gdsu::EdgeFileFormat::Text),
+                 std::system_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, BuildDSU) {
+    const auto edges = std::vector<Edge>{{1, 2}, {7, 8}, {2, 3}, {9, 9}, {3, 1}};
+
+    for (std::size_t numberOfThreads : {1, 2, 3, 8}) {
+        const auto dsu = gdsu::buildDSUFromEdges<gdsu::BaseRootDSUData<std::uint64_t>,
+                                                 gdsu::ComponentStats>(
+                edges, numberOfThreads, 2);
+
+        EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+        EXPECT_TRUE(dsu.inSameComponent(1, 3));
+        EXPECT_EQ(dsu.getComponentStats().getMaxComponentSize(), 3);
+        EXPECT_EQ(dsu.getComponentStats().getNumberOfSingletons(), 1);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, TextBatches) {
+    auto contents = std::string("# header\n");
+    auto expected = std::vector<std::uint64_t>();
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        contents += std::to_string(i) + " " + std::to_string(i * 3 % 1000) + "\n";
+        expected.push_back(i);
+        expected.push_back(i * 3 % 1000);
+    }
+    const auto path = writeTempFile("dsu_edges_batches.txt", contents);
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Text);
+
+    for (std::size_t batchBytes : {1, 5, 100, 1 << 20}) {
+        auto keys = std::vector<std::uint64_t>();
+        reader.forEachBatch(3, batchBytes, [&](std::span<const std::uint64_t> batch) {
+            EXPECT_EQ(batch.size() % 2, 0);
+            keys.insert(keys.end(), batch.begin(), batch.end());
+        });
+        EXPECT_EQ(keys, expected);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, BinaryBatchesAreViews) {
+    const auto keys = std::vector<std::uint64_t>{1, 2, 3, 4, 5, 6};
+    const auto path = writeTempFile(
+            "dsu_edges_views.bin",
+            std::string(reinterpret_cast<const char*>(keys.data()),
+                        keys.size() * sizeof(std::uint64_t)));
+    const auto reader = gdsu::EdgeFileReader<std::uint64_t>(
+            path, gdsu::EdgeFileFormat::Binary);
+
+    const std::uint64_t* expectedData = reader.viewBinaryKeys().data();
+    std::size_t numberOfBatches = 0;
+    reader.forEachBatch(2, 2 * sizeof(std::uint64_t),
+                        [&](std::span<const std::uint64_t> batch) {
+        EXPECT_EQ(batch.data(), expectedData);
+        EXPECT_EQ(batch.size(), 2);
+        expectedData += batch.size();
+        ++numberOfBatches;
+    });
+    EXPECT_EQ(numberOfBatches, 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(EdgeFileReader, BuildDSUFromFile) {
+    const auto textPath = writeTempFile("dsu_edges_build.txt",
+                                        "1 2\n7 8\n2 3\n9 9\n3 1\n");
+    const auto binaryKeys = std::vector<std::uint64_t>{1, 2, 7, 8, 2, 3, 9, 9, 3, 1};
+    const auto binaryPath = writeTempFile(
+            "dsu_edges_build.bin",
+            std::string(reinterpret_cast<const char*>(binaryKeys.data()),
+                        binaryKeys.size() * sizeof(std::uint64_t)));
+
+    for (const auto& [path, format] : {
+            std::pair{textPath, gdsu::EdgeFileFormat::Text},
+            std::pair{binaryPath, gdsu::EdgeFileFormat::Binary}}) {
+        const auto reader = gdsu::EdgeFileReader<std::uint64_t>(path, format);
+        for (std::size_t numberOfThreads : {1, 3}) {
+            const auto [dsu, numberOfEdges] =
+                    gdsu::buildDSUFromFile<gdsu::BaseRootDSUData<std::uint64_t>,
+                                           gdsu::ComponentStats>(
+                            reader, numberOfThreads, 8);
+
+            EXPECT_EQ(numberOfEdges, 5);
+            auto keys = std::vector<std::uint64_t>();
+            dsu.forEachKey([&](std::uint64_t key) { keys.push_back(key); });
+            EXPECT_EQ(keys, (std::vector<std::uint64_t>{1, 2, 3, 7, 8, 9}));
+            EXPECT_EQ(dsu.getNumberOfKeys(), 6);
+            EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+            EXPECT_TRUE(dsu.inSameComponent(1, 3));
+            EXPECT_EQ(dsu.getComponentStats().getMaxComponentSize(), 3);
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <FilterKruskal.hpp>
+#include "samples/greatest_element_dsu_data.hpp"
+
+namespace {
+    using Edge = gdsu::WeightedEdge<int, int>;
+
+    auto makeRandomEdges(int numberOfVertices,
+                         std::size_t numberOfEdges,
+                         int maxWeight) {
+        auto gen = std::mt19937(42);
+        auto vertexDist = std::uniform_int_distribution(0, numberOfVertices - 1);
+        auto weightDist = std::uniform_int_distribution(0, maxWeight);
+        auto edges = std::vector<Edge>();
+        for (std::size_t i = 0; i < numberOfEdges; ++i) {
+            edges.push_back(Edge{vertexDist(gen), vertexDist(gen), weightDist(gen)});
+        }
+        return edges;
+    }
+
+    long long sortedKruskalWeight(int numberOfVertices, std::vector<Edge> edges) {
+        auto keys = std::vector<int>(numberOfVertices);
+        std::iota(keys.begin(), keys.end(), 0);
+        auto dsu = gdsu::DSUWithData<int>(keys.begin(), keys.end());
+        std::sort(edges.begin(), edges.end(), [](const auto& e1, const auto& e2) {
+            return e1.weight < e2.weight;
+        });
+        long long ret = 0;
+        for (const auto& edge : edges) {
+            if (!dsu.inSameComponent(edge.from, edge.to)) {
+                dsu.join(edge.from, edge.to);
+                ret += edge.weight;
+            }
+        }
+        return ret;
+    }
+
+    long long forestWeight(const std::vector<Edge>& edges,
+                           const std::vector<std::size_t>& forest) {
+        long long ret = 0;
+        for (const auto edgeIdx : forest) {
+            ret += edges[edgeIdx].weight;
+        }
+        return ret;
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(FilterKruskal, SmallGraph) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3, 4, 5};
+    const auto edges = std::vector<Edge>{
+        {1, 2, 4}, {2, 3, 1}, {1, 3, 2}, {4, 5, 7}, {3, 3, 0}
+    };
+
+    const auto forest = gdsu::filterKruskal(dsu, edges);
+
+    EXPECT_EQ(forest, (std::vector<std::size_t>{1, 2, 3}));
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    EXPECT_TRUE(dsu.inSameComponent(1, 3));
+}
+
+//----------------------------------------------------------------------------//
+TEST(FilterKruskal, SameWeightAsSortedKruskal) {
+    constexpr int n = 3000;
+    const auto edges = makeRandomEdges(n, 100000, 1000);
+    auto keys = std::vector<int>(n);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    for (std::size_t numberOfThreads : {1, 4}) {
+        auto dsu = gdsu::DSUWithData<int>(keys.begin(), keys.end());
+        const auto forest = gdsu::filterKruskal(dsu, edges, numberOfThreads);
+
+        EXPECT_EQ(forest.size(), n - dsu.getNumberOfComponents());
+        EXPECT_EQ(forestWeight(edges, forest), sortedKruskalWeight(n, edges));
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(FilterKruskal, EqualWeights) {
+    constexpr int n = 500;
+    const auto edges = makeRandomEdges(n, 5000, 0);
+    auto keys = std::vector<int>(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    auto dsu = gdsu::DSUWithData<int>(keys.begin(), keys.end());
+
+    const auto forest = gdsu::filterKruskal(dsu, edges);
+
+    EXPECT_EQ(forest.size(), n - dsu.getNumberOfComponents());
+}
+
+//----------------------------------------------------------------------------//
+TEST(FilterKruskal, RootDataAggregates) {
+    auto dsu = gdsu::DeferredDSUWithData<int, GreatestElementRootDsuData<int>>{
+        1, 2, 3, 4, 5
+    };
+    dsu.join(4, 5);
+    const auto edges = std::vector<Edge>{{1, 2, 1}, {2, 4, 3}};
+
+    gdsu::filterKruskal(dsu, edges);
+
+    EXPECT_EQ(dsu.getRootData(1).getGreatest(), 5);
+    EXPECT_EQ(dsu.getRootData(3).getGreatest(), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(FilterKruskal, NoSuchKey) {
+    auto dsu = gdsu::DSUWithData<int>{1, 2, 3};
+    const auto edges = std::vector<Edge>{{1, 2, 1}, {2, 7, 3}};
+
+    EXPECT_THROW(gdsu::filterKruskal(dsu, edges, 2), std::invalid_argument);
+}
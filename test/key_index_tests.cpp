@@ -0,0 +1,115 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <EytzingerKeyIndex.hpp>
+#include <DSUWithData.hpp>
+
+namespace {
+    template<class KeyT>
+    auto makeSortedPairs(const std::vector<KeyT>& keys) {
+        auto ret = std::vector<std::pair<const KeyT*, std::size_t>>();
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ret.emplace_back(&keys[i], i);
+        }
+        return ret;
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, Empty) {
+    const auto index = gdsu::EytzingerKeyIndex<int>();
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.find(42), gdsu::EytzingerKeyIndex<int>::npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, FindAllSizes) {
+    for (int n = 1; n < 70; ++n) {
+        auto keys = std::vector<int>();
+        for (int i = 0; i < n; ++i) {
+            keys.push_back(2 * i);
+        }
+        const auto index = gdsu::EytzingerKeyIndex<int>(makeSortedPairs(keys));
+
+        ASSERT_EQ(index.size(), n);
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(index.find(2 * i), i);
+            ASSERT_EQ(index.find(2 * i + 1), gdsu::EytzingerKeyIndex<int>::npos);
+        }
+        ASSERT_EQ(index.find(-1), gdsu::EytzingerKeyIndex<int>::npos);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, GreaterComparator) {
+    const auto keys = std::vector<std::string>{"e", "d", "c", "b", "a"};
+    const auto index =
+            gdsu::EytzingerKeyIndex<std::string, std::greater<>>(
+                    makeSortedPairs(keys));
+
+    EXPECT_EQ(index.find("e"), 0);
+    EXPECT_EQ(index.find("a"), 4);
+    EXPECT_EQ(index.find("c"), 2);
+    EXPECT_EQ(index.find("f"), gdsu::EytzingerKeyIndex<std::string>::npos);
+    EXPECT_EQ(index.find("bb"), gdsu::EytzingerKeyIndex<std::string>::npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, DSUWithUnsortedRootData) {
+    auto dsu = gdsu::DSUWithData<int>{
+        gdsu::BaseRootDSUData<int>(7),
+        gdsu::BaseRootDSUData<int>(3),
+        gdsu::BaseRootDSUData<int>(5)
+    };
+
+    dsu.join(7, 5);
+
+    EXPECT_TRUE(dsu.inSameComponent(5, 7));
+    EXPECT_FALSE(dsu.inSameComponent(3, 7));
+    EXPECT_EQ(dsu.getRootData(3).getKey(), 3);
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, EraseAndCompact) {
+    const auto keys = std::vector<int>{10, 20, 30, 40, 50};
+    auto index = gdsu::EytzingerKeyIndex<int>(makeSortedPairs(keys));
+
+    EXPECT_EQ(index.erase(30), 2);
+    EXPECT_EQ(index.erase(30), gdsu::EytzingerKeyIndex<int>::npos);
+    EXPECT_EQ(index.find(30), gdsu::EytzingerKeyIndex<int>::npos);
+    EXPECT_EQ(index.find(40), 3);
+
+    constexpr auto npos = gdsu::EytzingerKeyIndex<int>::npos;
+    const auto compacted = index.compacted({0, 1, npos, 2, 3});
+
+    EXPECT_EQ(compacted.size(), 4);
+    EXPECT_EQ(compacted.find(10), 0);
+    EXPECT_EQ(compacted.find(40), 2);
+    EXPECT_EQ(compacted.find(50), 3);
+    EXPECT_EQ(compacted.find(30), npos);
+}
+
+//----------------------------------------------------------------------------//
+TEST(KeyIndex, ForEachInOrder) {
+    for (int n = 0; n < 70; ++n) {
+        auto keys = std::vector<int>();
+        for (int i = 0; i < n; ++i) {
+            keys.push_back(3 * i);
+        }
+        auto index = gdsu::EytzingerKeyIndex<int>(makeSortedPairs(keys));
+        if (n > 5) {
+            index.erase(3 * 5);
+            keys.erase(keys.begin() + 5);
+        }
+
+        auto visited = std::vector<int>();
+        index.forEach([&](int key) { visited.push_back(key); });
+        ASSERT_EQ(visited, keys);
+    }
+}
@@ -0,0 +1,117 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <PersistentDSU.hpp>
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, KeysConstructor) {
+    auto dsu = gdsu::PersistentDSU<int>{0, 1, 3, 3};
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    EXPECT_EQ(dsu.getTime(), 0);
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, ConstructFromVectorIterators) {
+    auto keysVec = std::vector<std::string>{"a", "b", "c", "b"};
+    auto dsu = gdsu::PersistentDSU<std::string>(keysVec.begin(), keysVec.end());
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 3);
+    dsu.join("a", "c");
+    EXPECT_TRUE(dsu.inSameComponent("c", "a"));
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, ConnectivityAtTime) {
+    auto dsu = gdsu::PersistentDSU<int>{1, 2, 3, 4, 5};
+
+    dsu.join(1, 2);  // t = 1
+    dsu.join(3, 4);  // t = 2
+    dsu.join(1, 2);  // t = 3
+    dsu.join(2, 4);  // t = 4
+
+    EXPECT_EQ(dsu.getTime(), 4);
+    EXPECT_FALSE(dsu.inSameComponentAt(1, 2, 0));
+    EXPECT_TRUE(dsu.inSameComponentAt(1, 2, 1));
+    EXPECT_FALSE(dsu.inSameComponentAt(3, 4, 1));
+    EXPECT_TRUE(dsu.inSameComponentAt(3, 4, 2));
+    EXPECT_FALSE(dsu.inSameComponentAt(1, 3, 3));
+    EXPECT_TRUE(dsu.inSameComponentAt(1, 3, 4));
+    EXPECT_TRUE(dsu.inSameComponentAt(1, 3, 100));
+    EXPECT_FALSE(dsu.inSameComponent(1, 5));
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, ComponentSizeAtTime) {
+    auto dsu = gdsu::PersistentDSU<int>{1, 2, 3, 4, 5};
+
+    dsu.join(1, 2);
+    dsu.join(3, 4);
+    dsu.join(5, 3);
+    dsu.join(2, 4);
+
+    EXPECT_EQ(dsu.getComponentSizeAt(1, 0), 1);
+    EXPECT_EQ(dsu.getComponentSizeAt(1, 1), 2);
+    EXPECT_EQ(dsu.getComponentSizeAt(4, 2), 2);
+    EXPECT_EQ(dsu.getComponentSizeAt(5, 2), 1);
+    EXPECT_EQ(dsu.getComponentSizeAt(5, 3), 3);
+    EXPECT_EQ(dsu.getComponentSizeAt(1, 3), 2);
+    EXPECT_EQ(dsu.getComponentSize(1), 5);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, ChainAgainstReplay) {
+    constexpr int n = 64;
+    auto keys = std::vector<int>(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    auto dsu = gdsu::PersistentDSU<int>(keys.begin(), keys.end());
+
+    for (int i = 1; i < n; ++i) {
+        dsu.join((i * 37) % n, (i * 37 + 1) % n);
+    }
+
+    for (std::size_t t = 0; t < n; ++t) {
+        auto replay = gdsu::PersistentDSU<int>(keys.begin(), keys.end());
+        for (std::size_t i = 1; i <= t && i < n; ++i) {
+            replay.join((i * 37) % n, (i * 37 + 1) % n);
+        }
+        for (int key = 0; key < n; ++key) {
+            ASSERT_EQ(dsu.getComponentSizeAt(key, t), replay.getComponentSize(key));
+            ASSERT_EQ(dsu.inSameComponentAt(0, key, t), replay.inSameComponent(0, key));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, StarSizeHistory) {
+    constexpr int n = 200;
+    auto keys = std::vector<int>(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    auto dsu = gdsu::PersistentDSU<int>(keys.begin(), keys.end());
+
+    // One root absorbs every other element, so its size history is long.
+    for (int i = 1; i < n; ++i) {
+        dsu.join(0, i);
+    }
+
+    for (std::size_t t = 0; t < n + 5; ++t) {
+        const auto expected = std::min<std::size_t>(t, n - 1) + 1;
+        ASSERT_EQ(dsu.getComponentSizeAt(0, t), expected);
+        ASSERT_EQ(dsu.getComponentSizeAt(n - 1, t), t < n - 1 ? 1 : n);
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(PersistentDSU, NoSuchKey) {
+    auto dsu = gdsu::PersistentDSU<int>{1, 2, 3};
+
+    EXPECT_THROW(dsu.join(3, 5), std::invalid_argument);
+    EXPECT_THROW(dsu.inSameComponentAt(4, 1, 0), std::invalid_argument);
+    EXPECT_THROW(dsu.getComponentSizeAt(42, 0), std::invalid_argument);
+}
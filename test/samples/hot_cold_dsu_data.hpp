@@ -0,0 +1,46 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_TEST_HOT_COLD_DSU_DATA_HPP
+#define DSU_TEST_HOT_COLD_DSU_DATA_HPP
+
+#include <algorithm>
+#include <vector>
+#include <DefaultDSUData.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+// class MembersRootDsuData
+// Keeps all component members (cold) and min/max (hot).
+class MembersRootDsuData : public gdsu::BaseRootDSUData<int> {
+public:
+    struct HotData {
+        explicit HotData(const MembersRootDsuData& rootData)
+            : min(rootData.getKey()), max(rootData.getKey()) {}
+
+        void joinWith(const HotData& other) {
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        int min;
+        int max;
+    };
+
+public:
+    explicit MembersRootDsuData(int key)
+        : gdsu::BaseRootDSUData<int>(key), _members{key} {};
+
+    void joinWith(const MembersRootDsuData& other) {
+        gdsu::BaseRootDSUData<int>::joinWith(other);
+        _members.insert(_members.end(),
+                        other._members.begin(), other._members.end());
+    }
+
+    [[nodiscard]] const std::vector<int>& getMembers() const { return _members; };
+
+private:
+    std::vector<int> _members;
+};
+
+#endif //DSU_TEST_HOT_COLD_DSU_DATA_HPP
@@ -0,0 +1,50 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#ifndef DSU_TEST_LAZY_DSU_DATA_HPP
+#define DSU_TEST_LAZY_DSU_DATA_HPP
+
+#include <cstddef>
+#include <vector>
+#include <DefaultDSUData.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+// class LazyMembersRootDsuData
+// Keeps all component members in join order. Merged lazily, counts merges.
+class LazyMembersRootDsuData : public gdsu::BaseRootDSUData<int> {
+public:
+    constexpr static bool lazyJoin = true;
+
+public:
+    explicit LazyMembersRootDsuData(int key)
+        : gdsu::BaseRootDSUData<int>(key), _members{key} {};
+
+    void joinWith(const LazyMembersRootDsuData& other) {
+        gdsu::BaseRootDSUData<int>::joinWith(other);
+        _members.insert(_members.end(),
+                        other._members.begin(), other._members.end());
+        ++numberOfMerges;
+    }
+
+    [[nodiscard]] const std::vector<int>& getMembers() const { return _members; };
+
+public:
+    inline static std::size_t numberOfMerges = 0;
+
+private:
+    std::vector<int> _members;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// class EagerMembersRootDsuData
+// Same as LazyMembersRootDsuData, merged on every join.
+class EagerMembersRootDsuData : public LazyMembersRootDsuData {
+public:
+    constexpr static bool lazyJoin = false;
+
+public:
+    using LazyMembersRootDsuData::LazyMembersRootDsuData;
+};
+
+#endif //DSU_TEST_LAZY_DSU_DATA_HPP
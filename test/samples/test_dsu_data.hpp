@@ -5,6 +5,7 @@
 #ifndef SIMPLE_DSU_SAMPLE_TEST_DSU_DATA_HPP
 #define SIMPLE_DSU_SAMPLE_TEST_DSU_DATA_HPP
 
+#include <cstddef>
 #include <DefaultDSUData.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -12,7 +13,7 @@
 class FloatAvgRootData : public gdsu::BaseRootDSUData<float> {
 public:
     explicit FloatAvgRootData(float key)
-        : gdsu::BaseRootDSUData<float>(key), _avg(key) {};
+        : gdsu::BaseRootDSUData<float>(key), _avg(key), _count(1) {};
 
     void joinWith(const FloatAvgRootData& other);
 
@@ -20,6 +21,23 @@ public:
 
 private:
     float _avg;
+    std::size_t _count;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// class WeightRootData
+// Sum of keys as the component weight, not related to component size.
+class WeightRootData : public gdsu::BaseRootDSUData<int> {
+public:
+    explicit WeightRootData(int key)
+        : gdsu::BaseRootDSUData<int>(key), _weight(key) {};
+
+    void joinWith(const WeightRootData& other) { _weight += other._weight; }
+
+    [[nodiscard]] int getWeight() const { return _weight; }
+
+private:
+    int _weight;
 };
 
 #endif //SIMPLE_DSU_SAMPLE_TEST_DSU_DATA_HPP
@@ -27,8 +45,10 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 //----------------------------------------------------------------------------//
 void FloatAvgRootData::joinWith(const FloatAvgRootData& other) {
-    _size += other._size;
-    _avg = (this->_avg + other._avg) / static_cast<float>(_size);
+    const auto count = static_cast<float>(_count);
+    const auto otherCount = static_cast<float>(other._count);
+    _avg = (_avg * count + other._avg * otherCount) / (count + otherCount);
+    _count += other._count;
 }
 
 //----------------------------------------------------------------------------//
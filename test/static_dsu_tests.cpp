@@ -0,0 +1,102 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <StaticDSUWithData.hpp>
+#include "samples/greatest_element_dsu_data.hpp"
+
+namespace {
+    constexpr auto makeJoinedStaticDSU() {
+        auto dsu = gdsu::StaticDSUWithData<int, 8>{5, 1, 3, 7, 3};
+        dsu.join(1, 3);
+        dsu.join(7, 3);
+        return dsu;
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, Constexpr) {
+    constexpr auto dsu = makeJoinedStaticDSU();
+
+    static_assert(dsu.getNumberOfComponents() == 2);
+    static_assert(dsu.inSameComponent(1, 7));
+    static_assert(!dsu.inSameComponent(1, 5));
+    static_assert(dsu.getComponentSize(7) == 3);
+    static_assert(dsu.getRootData(5).getKey() == 5);
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, JoinAndReset) {
+    auto dsu = gdsu::StaticDSUWithData<int, 4>{3, 4, 5, 6};
+
+    dsu.join(3, 4);
+    dsu.join(5, 6);
+    dsu.join(3, 6);
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+    EXPECT_EQ(dsu.getComponentSize(5), 4);
+
+    dsu.reset();
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 4);
+    EXPECT_EQ(dsu.getComponentSize(5), 1);
+    EXPECT_FALSE(dsu.inSameComponent(3, 4));
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, CustomData) {
+    auto keys = std::vector{1, 3, 6, 5};
+    auto dsu = gdsu::StaticDSUWithData<int, 16, GreatestElementRootDsuData<int>>(
+            keys.begin(), keys.end());
+
+    dsu.join(6, 1);
+    dsu.join(6, 3);
+
+    EXPECT_EQ(dsu.getRootData(3).getGreatest(), 6);
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, TooManyKeys) {
+    const auto action = []{
+        [[maybe_unused]] auto dsu = gdsu::StaticDSUWithData<int, 2>{1, 2, 3};
+    };
+
+    EXPECT_THROW(action(), std::length_error);
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, RepeatedKeysFitCapacity) {
+    auto dsu = gdsu::StaticDSUWithData<int, 2>{1, 2, 1, 2, 2};
+
+    EXPECT_EQ(dsu.getNumberOfComponents(), 2);
+    dsu.join(2, 1);
+    EXPECT_EQ(dsu.getComponentSize(1), 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, ConstexprManyRepeatedKeys) {
+    constexpr auto dsu = [] {
+        auto keys = std::array<int, 1000>{};
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = static_cast<int>(i * 7 % 250);
+        }
+        auto ret = gdsu::StaticDSUWithData<int, 250>(keys.begin(), keys.end());
+        ret.join(0, 249);
+        return ret;
+    }();
+
+    static_assert(dsu.getNumberOfComponents() == 249);
+    static_assert(dsu.getComponentSize(249) == 2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(StaticDSU, NoSuchKey) {
+    auto dsu = gdsu::StaticDSUWithData<int, 4>{1, 2, 3};
+
+    EXPECT_THROW(dsu.join(3, 5), std::invalid_argument);
+    EXPECT_THROW(dsu.getComponentSize(0), std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <DSUWithData.hpp>
+
+namespace {
+    using AdditiveDSU = gdsu::DSUWithData<int,
+                                          gdsu::BaseRootDSUData<int>,
+                                          std::less<int>,
+                                          gdsu::NoComponentStats,
+                                          gdsu::AdditiveOffsetGroup<long>>;
+
+    using ParityDSU = gdsu::DSUWithData<int,
+                                        gdsu::BaseRootDSUData<int>,
+                                        std::less<int>,
+                                        gdsu::NoComponentStats,
+                                        gdsu::ParityOffsetGroup>;
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, RelativeOffsets) {
+    auto dsu = AdditiveDSU{1, 2, 3, 4, 5};
+
+    EXPECT_TRUE(dsu.joinWithOffset(1, 2, 3));
+    EXPECT_TRUE(dsu.joinWithOffset(3, 2, -4));
+    EXPECT_TRUE(dsu.joinWithOffset(4, 5, 10));
+
+    EXPECT_EQ(dsu.getRelativeOffset(1, 2), 3);
+    EXPECT_EQ(dsu.getRelativeOffset(2, 1), -3);
+    EXPECT_EQ(dsu.getRelativeOffset(1, 3), 7);
+    EXPECT_EQ(dsu.getRelativeOffset(3, 3), 0);
+    EXPECT_EQ(dsu.getRelativeOffset(1, 4), std::nullopt);
+
+    EXPECT_TRUE(dsu.joinWithOffset(5, 3, 1));
+    EXPECT_EQ(dsu.getRelativeOffset(4, 1), 4);
+    EXPECT_EQ(dsu.getNumberOfComponents(), 1);
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, PlainJoinIsIdentityOffset) {
+    auto dsu = AdditiveDSU{1, 2, 3, 4};
+
+    EXPECT_TRUE(dsu.joinWithOffset(1, 2, 5));
+    dsu.join(3, 2);
+    dsu.join(1, 4);
+
+    EXPECT_EQ(dsu.getRelativeOffset(3, 2), 0);
+    EXPECT_EQ(dsu.getRelativeOffset(3, 1), -5);
+    EXPECT_EQ(dsu.getRelativeOffset(4, 1), 0);
+
+    // Already joined keys are not relinked.
+    dsu.join(1, 3);
+    EXPECT_EQ(dsu.getRelativeOffset(1, 3), 5);
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, Contradiction) {
+    auto dsu = AdditiveDSU{1, 2, 3};
+
+    EXPECT_TRUE(dsu.joinWithOffset(1, 2, 1));
+    EXPECT_TRUE(dsu.joinWithOffset(2, 3, 1));
+    EXPECT_TRUE(dsu.joinWithOffset(1, 3, 2));
+    EXPECT_FALSE(dsu.joinWithOffset(3, 1, 2));
+    EXPECT_EQ(dsu.getRelativeOffset(3, 1), -2);
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, Bipartiteness) {
+    auto dsu = ParityDSU{0, 1, 2, 3, 4};
+
+    // Even cycle.
+    EXPECT_TRUE(dsu.joinWithOffset(0, 1, true));
+    EXPECT_TRUE(dsu.joinWithOffset(1, 2, true));
+    EXPECT_TRUE(dsu.joinWithOffset(2, 3, true));
+    EXPECT_TRUE(dsu.joinWithOffset(3, 0, true));
+    EXPECT_EQ(dsu.getRelativeOffset(0, 2), false);
+
+    // Odd cycle.
+    EXPECT_TRUE(dsu.joinWithOffset(3, 4, true));
+    EXPECT_FALSE(dsu.joinWithOffset(4, 0, true));
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, RandomPotentials) {
+    constexpr int size = 1000;
+    auto gen = std::mt19937(42);
+    auto potentials = std::vector<long>(size);
+    for (auto& potential : potentials) {
+        potential = std::uniform_int_distribution<long>(-1000, 1000)(gen);
+    }
+
+    auto keys = std::vector<int>(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    auto dsu = AdditiveDSU(keys);
+
+    auto keyDistr = std::uniform_int_distribution<int>(0, size - 1);
+    for (int i = 0; i < 3 * size; ++i) {
+        const int key1 = keyDistr(gen);
+        const int key2 = keyDistr(gen);
+        EXPECT_TRUE(dsu.joinWithOffset(key1, key2,
+                                       potentials[key1] - potentials[key2]));
+        EXPECT_FALSE(dsu.joinWithOffset(key1, key2,
+                                        potentials[key1] - potentials[key2] + 1));
+    }
+
+    for (int i = 0; i < size; ++i) {
+        const int key1 = keyDistr(gen);
+        const int key2 = keyDistr(gen);
+        if (const auto offset = dsu.getRelativeOffset(key1, key2)) {
+            EXPECT_EQ(*offset, potentials[key1] - potentials[key2]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, OffsetsAfterCompact) {
+    auto dsu = AdditiveDSU{1, 2, 3, 4, 5, 6};
+
+    EXPECT_TRUE(dsu.joinWithOffset(1, 2, 5));
+    EXPECT_TRUE(dsu.joinWithOffset(3, 4, 7));
+    EXPECT_TRUE(dsu.joinWithOffset(2, 4, 1));
+    EXPECT_TRUE(dsu.joinWithOffset(5, 6, 2));
+    // Erase every possible root.
+    dsu.erase(1);
+    dsu.erase(3);
+    dsu.erase(5);
+    dsu.compact();
+
+    EXPECT_EQ(dsu.getRelativeOffset(2, 4), 1);
+    EXPECT_EQ(dsu.getRelativeOffset(4, 2), -1);
+    EXPECT_EQ(dsu.getRelativeOffset(6, 6), 0);
+    EXPECT_EQ(dsu.getRelativeOffset(2, 6), std::nullopt);
+    EXPECT_FALSE(dsu.joinWithOffset(4, 2, 0));
+}
+
+//----------------------------------------------------------------------------//
+TEST(WeightedDSU, OffsetsAfterReorder) {
+    auto dsu = AdditiveDSU{1, 2, 3, 4, 5, 6};
+
+    EXPECT_TRUE(dsu.joinWithOffset(6, 1, 4));
+    EXPECT_TRUE(dsu.joinWithOffset(3, 5, -2));
+    EXPECT_TRUE(dsu.joinWithOffset(1, 5, 1));
+    dsu.reorder(2);
+
+    EXPECT_EQ(dsu.getRelativeOffset(6, 3), 7);
+    EXPECT_EQ(dsu.getRelativeOffset(5, 1), -1);
+    EXPECT_EQ(dsu.getRelativeOffset(2, 1), std::nullopt);
+    EXPECT_FALSE(dsu.joinWithOffset(6, 5, 0));
+}
@@ -0,0 +1,98 @@
+//
+// Created by gogagum on 18.10.26.
+//
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <EdgeFileReader.hpp>
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: dsu_ingest [--binary] [--threads N] [--labels] "
+                     "<edge-file>\n"
+                     "  --binary     file is pairs of native endian uint64 keys\n"
+                     "  --threads N  number of parsing threads\n"
+                     "  --labels     print \"key root_key\" for every key\n";
+    }
+
+    bool parseNumberOfThreads(std::string_view arg, std::size_t& numberOfThreads) {
+        const auto [end, err] = std::from_chars(arg.data(), arg.data() + arg.size(),
+                                                numberOfThreads);
+        return err == std::errc() && end == arg.data() + arg.size()
+               && numberOfThreads != 0;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    using KeyT = std::uint64_t;
+
+    auto format = gdsu::EdgeFileFormat::Text;
+    std::size_t numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    bool printLabels = false;
+    std::string path;
+
+    for (int i = 1; i < argc; ++i) {
+        if (const auto arg = std::string(argv[i]); arg == "--binary") {
+            format = gdsu::EdgeFileFormat::Binary;
+        } else if (arg == "--labels") {
+            printLabels = true;
+        } else if (arg == "--threads" && i + 1 < argc
+                   && parseNumberOfThreads(argv[i + 1], numberOfThreads)) {
+            ++i;
+        } else if (path.empty() && !arg.starts_with("--")) {
+            path = arg;
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        const auto reader = gdsu::EdgeFileReader<KeyT>(path, format);
+        const auto [dsu, numberOfEdges] =
+                gdsu::buildDSUFromFile<gdsu::BaseRootDSUData<KeyT>,
+                                       gdsu::ComponentStats>(reader, numberOfThreads);
+        const double totalTime = secondsSince(start);
+
+        const auto& stats = dsu.getComponentStats();
+        std::cerr << "edges: " << numberOfEdges << '\n'
+                  << "keys: " << dsu.getNumberOfKeys() << '\n'
+                  << "components: " << dsu.getNumberOfComponents() << '\n'
+                  << "largest component: " << stats.getMaxComponentSize() << '\n'
+                  << "singletons: " << stats.getNumberOfSingletons() << '\n'
+                  << "total time: " << totalTime << " s\n";
+
+        if (printLabels) {
+            dsu.forEachKey([&](KeyT key) {
+                std::cout << key << ' ' << dsu.getRootData(key).getKey() << '\n';
+            });
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "dsu_ingest: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}